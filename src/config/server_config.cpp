@@ -3,8 +3,8 @@
 #include <fstream>
 #include <sstream>
 
-// jsoncpp  (Ʈ include path  )
-//  jsoncpp ̷  :
+// jsoncpp 헤더 (프로젝트 include path에 맞춰 조정)
+// 보통 jsoncpp는 이런 헤더를 씀:
 #include <json.h>
 
 namespace config {
@@ -16,6 +16,63 @@ namespace config {
         return oss.str();
     }
 
+    static void read_cpu_list(const Json::Value& v, std::vector<int>& out) {
+        out.clear();
+        if (!v.isArray()) return;
+        for (const auto& c : v) out.push_back(c.asInt());
+    }
+
+    static void read_aoi(const Json::Value& v, AoiConfig& out) {
+        if (v.isMember("sector_size")) out.sector_size = v["sector_size"].asFloat();
+        if (v.isMember("view_radius_sectors")) out.view_radius_sectors = v["view_radius_sectors"].asInt();
+        if (v.isMember("enter_radius")) out.enter_radius = v["enter_radius"].asFloat();
+        if (v.isMember("leave_radius")) out.leave_radius = v["leave_radius"].asFloat();
+        if (v.isMember("lod_near_radius")) out.lod_near_radius = v["lod_near_radius"].asFloat();
+        if (v.isMember("lod_mid_radius")) out.lod_mid_radius = v["lod_mid_radius"].asFloat();
+        if (v.isMember("lod_mid_interval_ticks")) out.lod_mid_interval_ticks = v["lod_mid_interval_ticks"].asUInt();
+        if (v.isMember("lod_far_min_move")) out.lod_far_min_move = v["lod_far_min_move"].asFloat();
+        if (v.isMember("lod_far_max_interval_ticks")) out.lod_far_max_interval_ticks = v["lod_far_max_interval_ticks"].asUInt();
+        if (v.isMember("move_quant_step")) out.move_quant_step = v["move_quant_step"].asFloat();
+        if (v.isMember("prefab_on_enter_only")) out.prefab_on_enter_only = v["prefab_on_enter_only"].asBool();
+        if (v.isMember("dead_reckoning")) out.dead_reckoning = v["dead_reckoning"].asBool();
+        if (v.isMember("dr_error_m")) out.dr_error_m = v["dr_error_m"].asFloat();
+        if (v.isMember("dr_refresh_ticks")) out.dr_refresh_ticks = v["dr_refresh_ticks"].asUInt();
+        if (v.isMember("max_visible")) out.max_visible = v["max_visible"].asUInt();
+        if (v.isMember("visible_player_weight")) out.visible_player_weight = v["visible_player_weight"].asFloat();
+        if (v.isMember("visible_npc_weight")) out.visible_npc_weight = v["visible_npc_weight"].asFloat();
+        if (v.isMember("visible_swap_margin")) out.visible_swap_margin = v["visible_swap_margin"].asFloat();
+        if (v.isMember("visible_rerank_ticks")) out.visible_rerank_ticks = v["visible_rerank_ticks"].asUInt();
+        if (v.isMember("send_budget_bytes_per_sec")) out.send_budget_bytes_per_sec = v["send_budget_bytes_per_sec"].asUInt();
+        if (v.isMember("send_focus_boost")) out.send_focus_boost = v["send_focus_boost"].asFloat();
+        if (v.isMember("hibernate_after_sec")) out.hibernate_after_sec = v["hibernate_after_sec"].asFloat();
+        if (v.isMember("freeze_unobserved")) out.freeze_unobserved = v["freeze_unobserved"].asBool();
+    }
+
+    static void read_partition(const Json::Value& v, FieldPartitionConfig& out) {
+        if (v.isMember("cols")) out.cols = v["cols"].asInt();
+        if (v.isMember("rows")) out.rows = v["rows"].asInt();
+        if (v.isMember("ghost_margin")) out.ghost_margin = v["ghost_margin"].asFloat();
+    }
+
+    static void read_channel(const Json::Value& v, FieldChannelConfig& out) {
+        if (v.isMember("soft_cap")) out.soft_cap = v["soft_cap"].asInt();
+        if (v.isMember("max_channels")) out.max_channels = v["max_channels"].asInt();
+        if (v.isMember("drain_ratio")) out.drain_ratio = v["drain_ratio"].asFloat();
+        if (v.isMember("reclaim_idle_sec")) out.reclaim_idle_sec = v["reclaim_idle_sec"].asInt();
+    }
+
+    static void read_path(const Json::Value& v, FieldPathConfig& out) {
+        if (v.isMember("threads")) out.threads = v["threads"].asInt();
+        if (v.isMember("cache_size")) out.cache_size = v["cache_size"].asInt();
+        if (v.isMember("max_requests_per_tick")) out.max_requests_per_tick = v["max_requests_per_tick"].asInt();
+        if (v.isMember("max_inflight")) out.max_inflight = v["max_inflight"].asInt();
+        if (v.isMember("max_expansions")) out.max_expansions = v["max_expansions"].asInt();
+        if (v.isMember("repath_dist")) out.repath_dist = v["repath_dist"].asFloat();
+        if (v.isMember("flow_min_chasers")) out.flow_min_chasers = v["flow_min_chasers"].asInt();
+        if (v.isMember("flow_radius")) out.flow_radius = v["flow_radius"].asFloat();
+        if (v.isMember("flow_builds_per_tick")) out.flow_builds_per_tick = v["flow_builds_per_tick"].asInt();
+    }
+
     bool LoadServerConfig(const std::string& path, ServerConfig& out, std::string* err) {
         std::ifstream ifs(path);
         if (!ifs.is_open()) {
@@ -61,6 +118,59 @@ namespace config {
             if (s.isMember("max_batch_uids")) out.storage.max_batch_uids = (std::size_t)s["max_batch_uids"].asUInt64();
         }
 
+        // game
+        if (root.isMember("game")) {
+            auto g = root["game"];
+            if (g.isMember("worker_shards")) out.game.worker_shards = (std::size_t)g["worker_shards"].asUInt64();
+        }
+
+        // field
+        //  - "aoi"/"partition"/"channel": 기본값, "overrides": { "fieldId": { 바꿀 항목만 } }
+        if (root.isMember("field")) {
+            auto f = root["field"];
+            if (f.isMember("aoi")) read_aoi(f["aoi"], out.field.aoi);
+            if (f.isMember("partition")) read_partition(f["partition"], out.field.partition);
+            if (f.isMember("channel")) read_channel(f["channel"], out.field.channel);
+            if (f.isMember("map_dir")) out.field.map_dir = f["map_dir"].asString();
+            if (f.isMember("path")) read_path(f["path"], out.field.path);
+
+            if (f.isMember("overrides")) {
+                const auto& ov = f["overrides"];
+                for (const auto& key : ov.getMemberNames()) {
+                    const int fieldId = std::stoi(key);
+
+                    AoiConfig c = out.field.aoi;
+                    if (ov[key].isMember("aoi")) read_aoi(ov[key]["aoi"], c);
+                    out.field.aoi_by_field[fieldId] = c;
+
+                    if (ov[key].isMember("partition")) {
+                        FieldPartitionConfig p = out.field.partition;
+                        read_partition(ov[key]["partition"], p);
+                        out.field.partition_by_field[fieldId] = p;
+                    }
+
+                    if (ov[key].isMember("channel")) {
+                        FieldChannelConfig ch = out.field.channel;
+                        read_channel(ov[key]["channel"], ch);
+                        out.field.channel_by_field[fieldId] = ch;
+                    }
+                }
+            }
+        }
+
+        // threads
+        if (root.isMember("threads")) {
+            auto t = root["threads"];
+            if (t.isMember("pin")) out.threads.pin = t["pin"].asBool();
+            read_cpu_list(t["io"], out.threads.io);
+            read_cpu_list(t["game"], out.threads.game);
+            read_cpu_list(t["field"], out.threads.field);
+            read_cpu_list(t["tick"], out.threads.tick);
+            read_cpu_list(t["db"], out.threads.db);
+            read_cpu_list(t["monitor"], out.threads.monitor);
+            read_cpu_list(t["path"], out.threads.path);
+        }
+
         return true;
     }
 
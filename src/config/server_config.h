@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 #include <cstdint>
+#include <vector>
+#include <unordered_map>
 
 namespace config {
 
@@ -25,13 +27,146 @@ namespace config {
         std::size_t max_batch_uids = 2000;
     };
 
+    struct GameConfig {
+        std::size_t worker_shards = 4;   // GameWorker 샤드 수 (로그인/디스패치 병렬화)
+    };
+
+    // 필드 AOI 설정 (거리 단위 m)
+    //  - enter_radius < leave_radius 로 두면 경계에서 Enter/Leave 가 반복되지 않음
+    //  - leave_radius 는 sector_size * view_radius_sectors 를 넘을 수 없음
+    struct AoiConfig {
+        float sector_size = 15.0f;
+        int   view_radius_sectors = 2;   // 후보 섹터 반경 (2 = 5x5)
+        float enter_radius = 26.0f;
+        float leave_radius = 30.0f;
+
+        // Move 전송 LOD (틱 = 필드 update 주기). lod_near_radius <= 0 이면 끔
+        float         lod_near_radius = 10.0f;          // 매 틱
+        float         lod_mid_radius = 20.0f;           // lod_mid_interval_ticks 마다
+        std::uint32_t lod_mid_interval_ticks = 3;
+        float         lod_far_min_move = 1.5f;          // 그 밖: 이만큼 움직였을 때만
+        std::uint32_t lod_far_max_interval_ticks = 20;  //        (늦어도 이 주기에는 최신 위치)
+
+        // 전송 위치 양자화 (m). 쌍별로 마지막 보낸 값과 같으면 Move 생략. 0 이하면 끔
+        float         move_quant_step = 0.05f;
+
+        // 클라 프로토콜: true 면 FieldCmd.prefab 을 Enter 에만 실음 (Move/Leave 는 빈 값)
+        //  - 클라가 "prefab 은 Enter 에서만 유효" 로 처리하도록 바뀐 뒤에만 켤 것. 기본은 매 이벤트 전송
+        bool          prefab_on_enter_only = false;
+
+        // dead reckoning: Move 에 속도를 실어 보내고 클라가 외삽. dr_error_m 이하 오차면 Move 생략
+        //  - 이동 중이면 dr_refresh_ticks 마다는 보정 Move. dead_reckoning=false 또는 dr_error_m <= 0 이면 끔
+        //  - 켜면 FieldCmd.dir 이 속도(m/s)로 쓰임. 클라가 외삽을 지원할 때만 켤 것
+        bool          dead_reckoning = false;
+        float         dr_error_m = 0.5f;
+        std::uint32_t dr_refresh_ticks = 20;
+
+        // watcher 당 가시 엔티티 상한 (몰림 대비). 0 이면 끔
+        //  - 우선순위: 타겟 > 거리² x 종류 가중치. visible_swap_margin 배 이상 가까워야 교체
+        std::uint32_t max_visible = 64;
+        float         visible_player_weight = 1.0f;
+        float         visible_npc_weight = 1.5f;
+        float         visible_swap_margin = 1.2f;
+        std::uint32_t visible_rerank_ticks = 10;
+
+        // watcher 당 송신 예산 (바이트/초). 남의 Move 는 쌍별 누적 우선순위 순으로 예산 안에서만
+        //  - 켜면 lod_*_interval 은 고정 주기가 아니라 우선순위 증가 속도로 쓰임. 0 이면 끔
+        std::uint32_t send_budget_bytes_per_sec = 32000;
+        float         send_focus_boost = 4.0f;      // 타겟 쌍 우선순위 증가 배수
+
+        // 관찰자 없을 때 CPU 절약
+        //  - hibernate_after_sec: 플레이어(인접 리전 ghost 포함)가 이만큼 없으면 리스폰 타이머만 돌림. 0 이면 끔
+        //  - freeze_unobserved: 어떤 플레이어 시야 창에도 없고 타겟도 없는 몬스터는 AI/이동 정지
+        float         hibernate_after_sec = 10.0f;
+        bool          freeze_unobserved = true;
+    };
+
+    // 한 필드를 여러 FieldWorker 가 나눠 맡는 분할 (cols x rows 리전)
+    //  - 1x1 = 분할 없음
+    //  - ghost_margin: 경계 밖 이 거리까지 인접 리전에 복제 (0 이하면 leave_radius 기준 자동)
+    struct FieldPartitionConfig {
+        int   cols = 1;
+        int   rows = 1;
+        float ghost_margin = 0.0f;
+    };
+
+    // 필드 채널(인스턴스) 자동 증설
+    //  - soft_cap <= 0 이면 채널 1개 고정 (기존 동작)
+    //  - 새 입장자는 가장 한산한 채널로, 전부 soft_cap 이상이면 채널 추가
+    //  - 인원이 줄면 번호 큰 채널부터 drain (새 입장 막음) -> 비면 회수
+    struct FieldChannelConfig {
+        int   soft_cap = 0;
+        int   max_channels = 1;
+        float drain_ratio = 0.5f;     // 채널 하나 빼도 나머지가 soft_cap * 이 비율 이하로 차면 drain
+        int   reclaim_idle_sec = 60;  // drain 채널이 이만큼 계속 비어 있으면 워커 정지
+    };
+
+    // 몬스터 경로 탐색 (충돌 맵 위 JPS, 전용 스레드에서 비동기)
+    //  - threads <= 0 이면 탐색 안 함 (막히면 벽 따라 미끄러지기만)
+    struct FieldPathConfig {
+        int   threads = 2;
+        int   cache_size = 256;           // 워커(리전)별 LRU 경로 캐시 개수
+        int   max_requests_per_tick = 16; // 워커 하나가 틱마다 새로 거는 요청 상한
+        int   max_inflight = 64;          // 워커 하나가 동시에 걸어둘 수 있는 요청 상한
+        int   max_expansions = 20000;     // 탐색 한 번에 여는 점프 포인트 상한 (넘으면 경로 없음)
+        float repath_dist = 2.0f;         // 목표가 이만큼 움직이면 다시 탐색
+
+        // 한 플레이어를 여럿이 쫓으면 개별 경로 대신 공유 흐름장 (목표 주변 창 위 Dijkstra)
+        int   flow_min_chasers = 6;       // 직선이 막힌 추적자가 이 이상이면 흐름장
+        float flow_radius = 24.0f;        // 창 반경 (m)
+        int   flow_builds_per_tick = 2;   // 워커 하나가 틱마다 새로 만드는 흐름장 상한
+    };
+
+    struct FieldConfig {
+        AoiConfig aoi;                                   // 기본값
+        std::unordered_map<int, AoiConfig> aoi_by_field; // fieldId 별 덮어쓰기
+
+        FieldPartitionConfig partition;                  // 기본값 (1x1)
+        std::unordered_map<int, FieldPartitionConfig> partition_by_field;
+
+        FieldChannelConfig channel;                      // 기본값 (채널 1개)
+        std::unordered_map<int, FieldChannelConfig> channel_by_field;
+
+        // 충돌 맵 폴더: <map_dir>/field_<fieldId>.cmap (비우거나 파일이 없으면 충돌 없음)
+        std::string map_dir;
+        FieldPathConfig path;
+
+        const AoiConfig& aoi_for(int fieldId) const {
+            auto it = aoi_by_field.find(fieldId);
+            return (it != aoi_by_field.end()) ? it->second : aoi;
+        }
+        const FieldPartitionConfig& partition_for(int fieldId) const {
+            auto it = partition_by_field.find(fieldId);
+            return (it != partition_by_field.end()) ? it->second : partition;
+        }
+        const FieldChannelConfig& channel_for(int fieldId) const {
+            auto it = channel_by_field.find(fieldId);
+            return (it != channel_by_field.end()) ? it->second : channel;
+        }
+    };
+
+    // 스레드 역할별 CPU 셋 (빈 배열 = 고정 안 함)
+    struct ThreadConfig {
+        bool pin = false;            // false 면 스레드 이름만 지정
+        std::vector<int> io;
+        std::vector<int> game;
+        std::vector<int> field;
+        std::vector<int> tick;
+        std::vector<int> db;
+        std::vector<int> monitor;
+        std::vector<int> path;
+    };
+
     struct ServerConfig {
         RedisConfig redis;
         MySqlConfig mysql;
         StorageConfig storage;
+        GameConfig game;
+        FieldConfig field;
+        ThreadConfig threads;
     };
 
-    // Ͽ ε (jsoncpp)
+    // 파일에서 로드 (jsoncpp)
     bool LoadServerConfig(const std::string& path, ServerConfig& out, std::string* err = nullptr);
 
 } // namespace config
@@ -0,0 +1,194 @@
+// AoiPairIndex.cpp
+#include "AoiPairIndex.h"
+
+namespace {
+    const std::vector<std::uint32_t> kEmptyList;
+    constexpr std::size_t kInitialSlots = 1024;
+}
+
+AoiPairIndex::AoiPairIndex()
+{
+    keys_.assign(kInitialSlots, kEmptyKey);
+    vals_.assign(kInitialSlots, kInvalid);
+    mask_ = kInitialSlots - 1;
+}
+
+std::uint64_t AoiPairIndex::hash_key(std::uint64_t k)
+{
+    // splitmix64 finalizer
+    k ^= k >> 30;
+    k *= 0xbf58476d1ce4e5b9ull;
+    k ^= k >> 27;
+    k *= 0x94d049bb133111ebull;
+    k ^= k >> 31;
+    return k;
+}
+
+std::size_t AoiPairIndex::probe(std::uint64_t key) const
+{
+    std::size_t slot = static_cast<std::size_t>(hash_key(key)) & mask_;
+    while (keys_[slot] != kEmptyKey && keys_[slot] != key)
+        slot = (slot + 1) & mask_;
+    return slot;
+}
+
+void AoiPairIndex::grow()
+{
+    std::vector<std::uint64_t> oldKeys;
+    std::vector<std::uint32_t> oldVals;
+    oldKeys.swap(keys_);
+    oldVals.swap(vals_);
+
+    const std::size_t cap = oldKeys.size() * 2;
+    keys_.assign(cap, kEmptyKey);
+    vals_.assign(cap, kInvalid);
+    mask_ = cap - 1;
+
+    for (std::size_t i = 0; i < oldKeys.size(); ++i) {
+        if (oldKeys[i] == kEmptyKey) continue;
+        const std::size_t slot = probe(oldKeys[i]);
+        keys_[slot] = oldKeys[i];
+        vals_[slot] = oldVals[i];
+    }
+}
+
+void AoiPairIndex::ensure_entity(std::uint32_t idx)
+{
+    if (idx >= byWatcher_.size()) {
+        byWatcher_.resize(idx + 1);
+        bySubject_.resize(idx + 1);
+    }
+}
+
+std::uint32_t AoiPairIndex::find(std::uint32_t watcher, std::uint32_t subject) const
+{
+    const std::size_t slot = probe(make_key(watcher, subject));
+    return (keys_[slot] == kEmptyKey) ? kInvalid : vals_[slot];
+}
+
+std::uint32_t AoiPairIndex::insert(std::uint32_t watcher, std::uint32_t subject, bool* inserted)
+{
+    const std::uint64_t key = make_key(watcher, subject);
+
+    // 부하율 1/2 넘기 전에 확장
+    if ((count_ + 1) * 2 > keys_.size())
+        grow();
+
+    const std::size_t slot = probe(key);
+    if (keys_[slot] != kEmptyKey) {
+        if (inserted) *inserted = false;
+        return vals_[slot];
+    }
+
+    std::uint32_t id;
+    if (!freePairs_.empty()) {
+        id = freePairs_.back();
+        freePairs_.pop_back();
+    }
+    else {
+        id = static_cast<std::uint32_t>(pairs_.size());
+        pairs_.emplace_back();
+    }
+
+    ensure_entity(watcher > subject ? watcher : subject);
+
+    Pair& p = pairs_[id];
+    p.watcher = watcher;
+    p.subject = subject;
+    p.watcherSlot = static_cast<std::uint32_t>(byWatcher_[watcher].size());
+    p.subjectSlot = static_cast<std::uint32_t>(bySubject_[subject].size());
+    byWatcher_[watcher].push_back(id);
+    bySubject_[subject].push_back(id);
+
+    keys_[slot] = key;
+    vals_[slot] = id;
+    ++count_;
+
+    if (inserted) *inserted = true;
+    return id;
+}
+
+void AoiPairIndex::erase_slot(std::size_t slot)
+{
+    // backward shift: 뒤에 밀려 있던 항목을 빈 자리로 당김
+    std::size_t hole = slot;
+    std::size_t next = (hole + 1) & mask_;
+    while (keys_[next] != kEmptyKey) {
+        const std::size_t home = static_cast<std::size_t>(hash_key(keys_[next])) & mask_;
+        // home 이 (hole, next] 구간 밖이면 hole 로 옮길 수 있음
+        const bool movable = (hole <= next)
+            ? (home <= hole || home > next)
+            : (home <= hole && home > next);
+        if (movable) {
+            keys_[hole] = keys_[next];
+            vals_[hole] = vals_[next];
+            hole = next;
+        }
+        next = (next + 1) & mask_;
+    }
+    keys_[hole] = kEmptyKey;
+    vals_[hole] = kInvalid;
+    --count_;
+}
+
+void AoiPairIndex::erase_pair(std::uint32_t id)
+{
+    Pair& p = pairs_[id];
+
+    // watcher 쪽 리스트 스왑-삭제
+    {
+        auto& list = byWatcher_[p.watcher];
+        const std::uint32_t last = list.back();
+        list[p.watcherSlot] = last;
+        pairs_[last].watcherSlot = p.watcherSlot;
+        list.pop_back();
+    }
+    // subject 쪽 리스트 스왑-삭제
+    {
+        auto& list = bySubject_[p.subject];
+        const std::uint32_t last = list.back();
+        list[p.subjectSlot] = last;
+        pairs_[last].subjectSlot = p.subjectSlot;
+        list.pop_back();
+    }
+
+    p = Pair{};
+    freePairs_.push_back(id);
+}
+
+bool AoiPairIndex::erase(std::uint32_t watcher, std::uint32_t subject)
+{
+    const std::size_t slot = probe(make_key(watcher, subject));
+    if (keys_[slot] == kEmptyKey)
+        return false;
+
+    const std::uint32_t id = vals_[slot];
+    erase_slot(slot);
+    erase_pair(id);
+    return true;
+}
+
+void AoiPairIndex::erase_entity(std::uint32_t idx)
+{
+    if (idx >= byWatcher_.size())
+        return;
+
+    while (!byWatcher_[idx].empty()) {
+        const Pair& p = pairs_[byWatcher_[idx].back()];
+        erase(p.watcher, p.subject);
+    }
+    while (!bySubject_[idx].empty()) {
+        const Pair& p = pairs_[bySubject_[idx].back()];
+        erase(p.watcher, p.subject);
+    }
+}
+
+const std::vector<std::uint32_t>& AoiPairIndex::watching(std::uint32_t watcher) const
+{
+    return (watcher < byWatcher_.size()) ? byWatcher_[watcher] : kEmptyList;
+}
+
+const std::vector<std::uint32_t>& AoiPairIndex::watched_by(std::uint32_t subject) const
+{
+    return (subject < bySubject_.size()) ? bySubject_[subject] : kEmptyList;
+}
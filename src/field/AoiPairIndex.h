@@ -0,0 +1,74 @@
+// AoiPairIndex.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// =======================
+// watcher <-> subject 가시 쌍 양방향 인덱스
+//  - 키는 AoiWorld pool 인덱스 두 개 (watcher, subject)
+//  - 쌍 조회/추가/삭제 O(1): open addressing 해시 + 엔티티별 스왑-삭제 리스트
+//  - pair id 는 삭제 전까지 고정이라 쌍 단위 상태를 붙이는 키로 써도 됨
+// =======================
+class AoiPairIndex
+{
+public:
+    static constexpr std::uint32_t kInvalid = 0xFFFFFFFFu;
+
+    struct Pair
+    {
+        std::uint32_t watcher = kInvalid;
+        std::uint32_t subject = kInvalid;
+        std::uint32_t watcherSlot = kInvalid; // byWatcher_[watcher] 내 위치
+        std::uint32_t subjectSlot = kInvalid; // bySubject_[subject] 내 위치
+    };
+
+    AoiPairIndex();
+
+    // 쌍 추가 (이미 있으면 기존 pair id 반환)
+    std::uint32_t insert(std::uint32_t watcher, std::uint32_t subject, bool* inserted = nullptr);
+    bool          erase(std::uint32_t watcher, std::uint32_t subject);
+
+    std::uint32_t find(std::uint32_t watcher, std::uint32_t subject) const;
+    bool          contains(std::uint32_t watcher, std::uint32_t subject) const {
+        return find(watcher, subject) != kInvalid;
+    }
+
+    // 엔티티가 사라질 때: watcher/subject 양쪽으로 걸린 쌍 전부 삭제
+    void erase_entity(std::uint32_t idx);
+
+    // 엔티티별 pair id 목록 (순서 의미 없음)
+    const std::vector<std::uint32_t>& watching(std::uint32_t watcher) const;   // 내가 보는 쌍
+    const std::vector<std::uint32_t>& watched_by(std::uint32_t subject) const; // 나를 보는 쌍
+
+    const Pair& pair(std::uint32_t id) const { return pairs_[id]; }
+    std::size_t size() const { return count_; }
+
+private:
+    static constexpr std::uint64_t kEmptyKey = ~0ull;
+
+    static std::uint64_t make_key(std::uint32_t w, std::uint32_t s) {
+        return (static_cast<std::uint64_t>(w) << 32) | s;
+    }
+    static std::uint64_t hash_key(std::uint64_t k);
+
+    std::size_t probe(std::uint64_t key) const; // key 가 있거나 들어갈 슬롯
+    void        grow();
+    void        erase_slot(std::size_t slot);
+    void        erase_pair(std::uint32_t id);
+
+    void ensure_entity(std::uint32_t idx);
+
+private:
+    // open addressing (선형 탐사, 삭제는 backward shift 라 tombstone 없음)
+    std::vector<std::uint64_t> keys_;
+    std::vector<std::uint32_t> vals_;   // 슬롯 -> pair id
+    std::size_t                mask_ = 0;
+    std::size_t                count_ = 0;
+
+    std::vector<Pair>          pairs_;
+    std::vector<std::uint32_t> freePairs_;
+
+    std::vector<std::vector<std::uint32_t>> byWatcher_; // 엔티티 idx -> pair ids
+    std::vector<std::vector<std::uint32_t>> bySubject_;
+};
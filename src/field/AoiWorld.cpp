@@ -6,10 +6,132 @@
 //--------------------------------------------
 // ctor
 //--------------------------------------------
-AoiWorld::AoiWorld(float sectorSize, int viewRadiusSectors)
+AoiWorld::AoiWorld(float sectorSize, int viewRadiusSectors, float worldWidth, float worldHeight)
     : sectorSize_(sectorSize > 0.0f ? sectorSize : 1.0f)
     , viewRadius_(viewRadiusSectors > 0 ? viewRadiusSectors : 1)
 {
+    width_ = std::max(1, static_cast<int>(std::ceil(worldWidth / sectorSize_)));
+    height_ = std::max(1, static_cast<int>(std::ceil(worldHeight / sectorSize_)));
+
+    // 필드 크기가 정해져 있으니 섹터는 처음에 전부 만들어 둠
+    sectors_.resize(static_cast<std::size_t>(width_) * height_);
+
+    // 기본값: 구독 창이 덮는 거리 전체 (히스테리시스 없음)
+    set_interest_radius(0.0f, 0.0f);
+}
+
+void AoiWorld::set_interest_radius(float enterRadius, float leaveRadius)
+{
+    // 보이는 쌍은 항상 watcher 구독 창 안에 있어야 하므로 leave 는 창이 덮는 거리까지만
+    const float maxRadius = sectorSize_ * static_cast<float>(viewRadius_);
+
+    float leave = (leaveRadius > 0.0f) ? std::min(leaveRadius, maxRadius) : maxRadius;
+    float enter = (enterRadius > 0.0f) ? std::min(enterRadius, leave) : leave;
+
+    enterRadius2_ = enter * enter;
+    leaveRadius2_ = leave * leave;
+
+    // watcher 쪽 재평가 간격: 히스테리시스 폭의 1/4 만큼 움직일 때마다
+    //  - enter == leave (폭 0) 면 매 이동마다 창 전체를 훑게 되므로 섹터 크기의 1/10 을 하한으로
+    const float reeval = std::max((leave - enter) * 0.25f, sectorSize_ * 0.1f);
+    reevalDist2_ = reeval * reeval;
+}
+
+void AoiWorld::set_lod(const AoiLodParams& lod)
+{
+    lod_ = lod;
+    lodNear2_ = lod.nearRadius * lod.nearRadius;
+    lodMid2_ = std::max(lod.midRadius, lod.nearRadius);
+    lodMid2_ *= lodMid2_;
+    lodFarMove2_ = lod.farMinMove * lod.farMinMove;
+    if (lod_.midInterval == 0) lod_.midInterval = 1;
+    if (lod_.farMaxInterval == 0) lod_.farMaxInterval = 1;
+}
+
+void AoiWorld::set_move_quantization(float step)
+{
+    quantStep_ = (step > 0.0f) ? step : 0.0f;
+    invQuantStep_ = (step > 0.0f) ? 1.0f / step : 0.0f;
+}
+
+AoiVec2 AoiWorld::quantize(const AoiVec2& p) const
+{
+    if (quantStep_ <= 0.0f)
+        return p;
+    return AoiVec2{ std::round(p.x * invQuantStep_) * quantStep_,
+                    std::round(p.y * invQuantStep_) * quantStep_ };
+}
+
+void AoiWorld::set_dead_reckoning(float errorM, std::uint32_t refreshFrames, float frameSec)
+{
+    drError2_ = (errorM > 0.0f) ? errorM * errorM : 0.0f;
+    drRefresh_ = (refreshFrames > 0) ? refreshFrames : 1;
+    frameSec_ = (frameSec > 0.0f) ? frameSec : 0.05f;
+}
+
+void AoiWorld::set_visibility_cap(const AoiVisibilityParams& vis)
+{
+    vis_ = vis;
+    if (vis_.maxVisible == 1) vis_.maxVisible = 2;    // focus 하나가 자리를 다 먹지 않도록
+    if (vis_.rerankInterval == 0) vis_.rerankInterval = 1;
+    const float margin = std::max(vis.swapMargin, 1.0f);
+    swapMargin2_ = margin * margin;
+}
+
+void AoiWorld::set_focus(std::uint64_t watcherId, std::uint64_t subjectId)
+{
+    const std::uint32_t w = find_index(watcherId);
+    if (w == kInvalidIndex || !pool_[w].isPlayer)
+        return;
+
+    Entity& we = pool_[w];
+    we.focusId = subjectId;
+
+    // 반경 안인데 상한 때문에 안 보이고 있었으면 지금 들임
+    const std::uint32_t s = find_index(subjectId);
+    if (s == kInvalidIndex || s == w || pairs_.contains(w, s))
+        return;
+
+    const Entity& o = pool_[s];
+    if (we.window.contains(o.sector.x, o.sector.y) && dist2(we.pos, o.pos) <= enterRadius2_ && admit(w, s))
+        emit(w, s, make_event(AoiEvent::Type::Snapshot, o));
+}
+
+void AoiWorld::set_send_budget(const AoiSendBudget& budget)
+{
+    budget_ = budget;
+    if (budget_.bytesPerFrame > 0)  // 최소한 틱당 Move 하나는 나가도록
+        budget_.bytesPerFrame = std::max(budget_.bytesPerFrame, budget_.moveBytes);
+    if (budget_.focusBoost < 1.0f) budget_.focusBoost = 1.0f;
+}
+
+bool AoiWorld::client_in_sync(std::uint32_t pairId, const Entity& subject) const
+{
+    const PairState& st = pairState_[pairId];
+    const AoiVec2 q = quantize(subject.pos);
+
+    // 이 정도 속도 차이는 같은 이동으로 봄 (추적 중 미세한 방향 변화는 오차 판정에 맡김)
+    constexpr float kVelEps2 = 0.25f * 0.25f;
+
+    if (drError2_ <= 0.0f || (st.lastSentVel.x == 0.0f && st.lastSentVel.y == 0.0f)) {
+        // 멈춰 있다고 알려준 상태: 새로 움직이기 시작했거나 위치가 달라지면 보냄
+        if (dist2(subject.vel, st.lastSentVel) > kVelEps2)
+            return false;
+        return q.x == st.lastSentPos.x && q.y == st.lastSentPos.y;
+    }
+
+    // 이동 중: 속도 변경(정지 포함) / 보정 주기 / 외삽 오차
+    if (dist2(subject.vel, st.lastSentVel) > kVelEps2)
+        return false;
+
+    const std::uint32_t frames = frame_ - st.lastSentFrame;
+    if (frames >= drRefresh_)
+        return false;
+
+    const float t = static_cast<float>(frames) * frameSec_;
+    const AoiVec2 predicted{ st.lastSentPos.x + st.lastSentVel.x * t,
+                             st.lastSentPos.y + st.lastSentVel.y * t };
+    return dist2(q, predicted) <= drError2_;
 }
 
 //--------------------------------------------
@@ -18,176 +140,247 @@ AoiWorld::AoiWorld(float sectorSize, int viewRadiusSectors)
 
 void AoiWorld::add_entity(uint64_t id, bool isPlayer, const AoiVec2& pos)
 {
-    Entity e;
+    // 같은 id 재등록이면 기존 것부터 정리 (섹터에 유령이 남지 않도록)
+    if (find_index(id) != kInvalidIndex)
+        remove_entity(id);
+
+    std::uint32_t idx;
+    if (!freeSlots_.empty()) {
+        idx = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+    else {
+        idx = static_cast<std::uint32_t>(pool_.size());
+        pool_.emplace_back();
+    }
+
+    // 1. 엔티티 등록
+    Entity& e = pool_[idx];
+    e = Entity{};
     e.id = id;
     e.isPlayer = isPlayer;
+    e.playerKind = isPlayer;
+    e.alive = true;
     e.pos = pos;
     e.sector = world_to_sector(pos);
+    e.sectorIndex = sector_index(e.sector);
 
-    // 1. ƼƼ 
-    entities_[id] = e;
-    enter_sector(id, e.sector);
+    index_[id] = idx;
+    enter_sector(idx);
 
-    // 2. ÷̾    (߿!)
+    // 2. 플레이어면 자기 자신 Snapshot + 구독 섹터 계산 + 반경 안 엔티티 Snapshot
+    //  - 입장 시 클라가 받는 초기 상태는 전부 이 watcher 의 이벤트 묶음 하나로 나감
     if (isPlayer) {
-        rebuild_player_subscriptions(entities_[id]);
+        emit(idx, idx, make_event(AoiEvent::Type::Snapshot, e));
+        rebuild_player_subscriptions(idx);
+        evaluate_watcher(idx);
     }
 
-    //// 3.  ÷̾  ƼƼ  
-    //if (isPlayer && sendCb_) {
-    //    for (auto& [otherId, other] : entities_) {
-    //        if (otherId == id) continue;
-
-    //        AoiEvent ev;
-    //        ev.type = AoiEvent::Type::Snapshot;
-    //        ev.subjectId = otherId;
-    //        ev.position = other.pos;
-    //        sendCb_(id, ev);
-    //    }
-    //}
-
-    // 4.  watcher鿡 Enter ˸
-    if (sendCb_) {
-        AoiEvent ev;
-        ev.type = AoiEvent::Type::Enter;
-        ev.subjectId = id;
-        ev.position = pos;
-
-        broadcast_to_sector_watchers(e.sector, ev, id);
-
-    }
+    // 3. 반경 안 watcher들에게 Enter 알림
+    evaluate_subject(idx, /*sendMove=*/false);
 }
 
 
 
 void AoiWorld::remove_entity(std::uint64_t id)
 {
-    auto it = entities_.find(id);
-    if (it == entities_.end())
+    const std::uint32_t idx = find_index(id);
+    if (idx == kInvalidIndex)
         return;
 
-    Entity& e = it->second;
-
-    //    ƼƼ  ִ watcher鿡 Leave ˸
-    if (sendCb_) {
-        AoiEvent ev;
-        ev.type = AoiEvent::Type::Leave;
-        ev.subjectId = id;
-        ev.position = e.pos;
+    Entity& e = pool_[idx];
 
-        broadcast_to_sector_watchers(e.sector, ev, id);
+    // 나를 보고 있던 watcher들에게 Leave 알림 (뒤에서부터: Leave 가 리스트를 스왑-삭제함)
+    for (std::size_t k = pairs_.watched_by(idx).size(); k-- > 0;) {
+        const std::uint32_t w = pairs_.pair(pairs_.watched_by(idx)[k]).watcher;
+        if (w == idx) continue;
+        emit(w, idx, make_event(AoiEvent::Type::Leave, e));
     }
 
-    // Ϳ 
-    leave_sector(id, e.sector);
+    // 섹터에서 제거
+    leave_sector(idx);
 
-    // ÷̾  Ϳ watcher 
-    if (e.isPlayer) {
-        for (const auto& sc : e.subscribed) {
-            auto sit = sectors_.find(sc);
-            if (sit != sectors_.end()) {
-                sit->second.watchers.erase(e.id);
-            }
-        }
-        e.subscribed.clear();
-    }
+    // Leave 로 안 지워진 쌍(자기 자신 쌍, 내가 보던 쌍) 정리
+    pairs_.erase_entity(idx);
+
+    // 플레이어면 구독 섹터에서 watcher 제거
+    if (e.isPlayer)
+        unsubscribe_all(idx);
+
+    if (e.ghost && e.playerKind)
+        --ghostPlayers_;
 
-    entities_.erase(it);
+    e.alive = false;
+    e.ghost = false;
+    index_.erase(id);
+    freeSlots_.push_back(idx);
 }
 
 void AoiWorld::move_entity(std::uint64_t id, const AoiVec2& newPos)
 {
-    auto it = entities_.find(id);
-    if (it == entities_.end()) return;
+    move_entity(id, newPos, AoiVec2{});
+}
+
+void AoiWorld::move_entity(std::uint64_t id, const AoiVec2& newPos, const AoiVec2& velocity)
+{
+    const std::uint32_t idx = find_index(id);
+    if (idx == kInvalidIndex) return;
 
-    Entity& e = it->second;
-    AoiSectorCoord oldSector = e.sector;
+    Entity& e = pool_[idx];
+    const AoiSectorCoord oldSector = e.sector;
 
     e.pos = newPos;
-    e.sector = world_to_sector(newPos);
+    e.vel = (drError2_ > 0.0f) ? velocity : AoiVec2{};
+    const AoiSectorCoord newSector = world_to_sector(newPos);
 
-    bool sectorChanged = !(e.sector == oldSector);
+    bool sectorChanged = !(newSector == oldSector);
 
-    // 2)  membership ̵
+    // 1) 섹터 membership 이동
     if (sectorChanged) {
-        leave_sector(id, oldSector);
-        enter_sector(id, e.sector);
+        leave_sector(idx);
+        e.sector = newSector;
+        e.sectorIndex = sector_index(newSector);
+        enter_sector(idx);
     }
 
-    // 3) ÷̾ ڱ   
-    if (e.isPlayer) {
-        rebuild_player_subscriptions(e);
+    // 2) 플레이어면 자기 구독 섹터 갱신 (같은 섹터 안 이동이면 구독은 그대로)
+    if (e.isPlayer && sectorChanged) {
+        rebuild_player_subscriptions(idx);
     }
 
-    if (!sendCb_) return;
-
-    // sectorChanged  old/new watcher  Leave/Enter
-    if (sectorChanged) {
-        const Sector* oldS = get_sector(oldSector);
-        const Sector* newS = get_sector(e.sector);
-
-        // oldWatchers - newWatchers => Leave
-        if (oldS) {
-            for (auto watcherId : oldS->watchers) {
-                if (newS && newS->watchers.find(watcherId) != newS->watchers.end())
-                    continue; //    
-                if (watcherId == id) continue;
-
-                AoiEvent leaveEv;
-                leaveEv.type = AoiEvent::Type::Leave;
-                leaveEv.subjectId = id;
-                leaveEv.position = e.pos;
-                sendCb_(watcherId, leaveEv);
-            }
-        }
+    // 3) subject 쪽: 나를 보는 watcher 에게 Move/Leave, 새로 반경에 들어온 watcher 에게 Enter
+    evaluate_subject(idx, /*sendMove=*/true);
 
-        // newWatchers - oldWatchers => Enter (Ǵ Snapshot)
-        if (newS) {
-            for (auto watcherId : newS->watchers) {
-                if (oldS && oldS->watchers.find(watcherId) != oldS->watchers.end())
-                    continue; //  
-                if (watcherId == id) continue;
-
-                AoiEvent enterEv;
-                enterEv.type = AoiEvent::Type::Enter; // Snapshot ص OK
-                enterEv.subjectId = id;
-                enterEv.position = e.pos;
-                sendCb_(watcherId, enterEv);
-            }
-        }
+    // 4) watcher 쪽: 섹터를 넘었거나 충분히 움직였을 때만 내 시야 재평가
+    if (e.isPlayer && (sectorChanged || dist2(e.pos, e.evalPos) >= reevalDist2_)) {
+        evaluate_watcher(idx);
     }
+}
 
-    // 4) Move " " watcherԸ
-    {
-        AoiEvent ev;
-        ev.type = AoiEvent::Type::Move;
-        ev.subjectId = id;
-        ev.position = e.pos;
 
-        broadcast_to_sector_watchers(e.sector, ev, id);
-        if (e.isPlayer) {
-            sendCb_(id, ev);
-        }
+
+//--------------------------------------------
+// public: 리전 경계 (ghost / 핸드오프)
+//--------------------------------------------
+
+void AoiWorld::add_ghost(std::uint64_t id, const AoiVec2& pos, bool playerKind)
+{
+    // watcher 가 아니므로 몬스터와 같은 경로로 등록 (이 리전 watcher 에게 Enter)
+    add_entity(id, /*isPlayer=*/false, pos);
+
+    Entity& e = pool_[find_index(id)];
+    e.ghost = true;
+    e.playerKind = playerKind;
+    if (playerKind)
+        ++ghostPlayers_;
+}
+
+bool AoiWorld::is_ghost(std::uint64_t id) const
+{
+    const std::uint32_t idx = find_index(id);
+    return idx != kInvalidIndex && pool_[idx].ghost;
+}
+
+bool AoiWorld::demote_to_ghost(std::uint64_t id, std::vector<std::uint64_t>& visibleOut)
+{
+    visibleOut.clear();
+
+    const std::uint32_t idx = find_index(id);
+    if (idx == kInvalidIndex || !pool_[idx].isPlayer)
+        return false;
+
+    // 내가 보던 쌍: 클라 시야는 새 소유 리전이 이어받으므로 Leave 없이 끊음
+    while (!pairs_.watching(idx).empty()) {
+        const std::uint32_t pairId = pairs_.watching(idx).back();
+        const std::uint32_t s = pairs_.pair(pairId).subject;
+        if (s != idx)
+            visibleOut.push_back(pool_[s].id);
+
+        pairState_[pairId].pending = false;
+        pairs_.erase(idx, s);
     }
+
+    unsubscribe_all(idx);
+
+    // players 목록에서 빠지도록 섹터 재등록
+    Entity& e = pool_[idx];
+    leave_sector(idx);
+    e.isPlayer = false;
+    e.ghost = true;
+    enter_sector(idx);
+    ++ghostPlayers_;
+    return true;
 }
 
+void AoiWorld::adopt_player(std::uint64_t id, const AoiVec2& pos, const std::vector<std::uint64_t>& visible)
+{
+    std::uint32_t idx = find_index(id);
+    if (idx != kInvalidIndex && !pool_[idx].ghost) {
+        move_entity(id, pos);   // 이미 이 리전 소유
+        return;
+    }
+
+    // ghost 가 아직 안 왔으면 새로 (이 리전 watcher 에게는 Enter)
+    if (idx == kInvalidIndex) {
+        add_ghost(id, pos);
+        idx = find_index(id);
+    }
+
+    // ghost -> 플레이어 (나를 보던 쌍은 유지)
+    Entity& e = pool_[idx];
+    if (e.playerKind)
+        --ghostPlayers_;
+    leave_sector(idx);
+    e.ghost = false;
+    e.isPlayer = true;
+    e.playerKind = true;
+    e.pos = pos;
+    e.sector = world_to_sector(pos);
+    e.sectorIndex = sector_index(e.sector);
+    enter_sector(idx);
+    rebuild_player_subscriptions(idx);
+
+    // 클라가 이미 보고 있는 것: 최신 위치 Move 로 쌍만 이음 (Snapshot 생략)
+    for (auto sid : visible) {
+        const std::uint32_t s = find_index(sid);
+        if (s == idx)
+            continue;
+
+        if (s == kInvalidIndex) {
+            AoiEvent ev;
+            ev.type = AoiEvent::Type::Leave;
+            ev.subjectId = sid;
+            events_.push(id, ev);
+            continue;
+        }
+
+        const Entity& o = pool_[s];
+        if (e.window.contains(o.sector.x, o.sector.y) && dist2(e.pos, o.pos) <= leaveRadius2_)
+            emit(idx, s, make_event(AoiEvent::Type::Move, o));
+        else
+            events_.push(id, make_event(AoiEvent::Type::Leave, o));
+    }
 
+    // 나머지 반경 안 엔티티는 Snapshot, 이 리전 watcher 에게는 Move/Enter
+    evaluate_watcher(idx);
+    evaluate_subject(idx, /*sendMove=*/true);
+}
 
 //--------------------------------------------
-// public: player AOI 
+// public: player AOI만 갱신
 //--------------------------------------------
 
 void AoiWorld::update_player_aoi(std::uint64_t playerId)
 {
-    auto it = entities_.find(playerId);
-    if (it == entities_.end())
+    const std::uint32_t idx = find_index(playerId);
+    if (idx == kInvalidIndex)
         return;
 
-    Entity& e = it->second;
-    if (!e.isPlayer)
+    if (!pool_[idx].isPlayer)
         return;
 
-    rebuild_player_subscriptions(e);
+    rebuild_player_subscriptions(idx);
+    evaluate_watcher(idx);
 }
 
 //--------------------------------------------
@@ -196,14 +389,20 @@ void AoiWorld::update_player_aoi(std::uint64_t playerId)
 
 const AoiWorld::Entity* AoiWorld::get_entity(std::uint64_t id) const
 {
-    auto it = entities_.find(id);
-    return (it == entities_.end()) ? nullptr : &it->second;
+    const std::uint32_t idx = find_index(id);
+    return (idx == kInvalidIndex) ? nullptr : &pool_[idx];
 }
 
 AoiWorld::Entity* AoiWorld::get_entity(std::uint64_t id)
 {
-    auto it = entities_.find(id);
-    return (it == entities_.end()) ? nullptr : &it->second;
+    const std::uint32_t idx = find_index(id);
+    return (idx == kInvalidIndex) ? nullptr : &pool_[idx];
+}
+
+std::uint32_t AoiWorld::find_index(std::uint64_t id) const
+{
+    auto it = index_.find(id);
+    return (it == index_.end()) ? kInvalidIndex : it->second;
 }
 
 //--------------------------------------------
@@ -215,171 +414,696 @@ AoiSectorCoord AoiWorld::world_to_sector(const AoiVec2& pos) const
     int sx = static_cast<int>(std::floor(pos.x / sectorSize_));
     int sy = static_cast<int>(std::floor(pos.y / sectorSize_));
 
-    if (sx < 0) sx = 0;
-    if (sy < 0) sy = 0;
+    sx = std::clamp(sx, 0, width_ - 1);
+    sy = std::clamp(sy, 0, height_ - 1);
 
     return { sx, sy };
 }
 
+AoiSectorRect AoiWorld::view_window(const AoiSectorCoord& center) const
+{
+    AoiSectorRect r;
+    r.minX = std::max(0, center.x - viewRadius_);
+    r.minY = std::max(0, center.y - viewRadius_);
+    r.maxX = std::min(width_ - 1, center.x + viewRadius_);
+    r.maxY = std::min(height_ - 1, center.y + viewRadius_);
+    return r;
+}
+
 //--------------------------------------------
-// private: sector access
+// private: sector membership (스왑-삭제)
 //--------------------------------------------
 
-AoiWorld::Sector* AoiWorld::get_or_create_sector(const AoiSectorCoord& c)
+void AoiWorld::enter_sector(std::uint32_t idx)
 {
-    auto it = sectors_.find(c);
-    if (it != sectors_.end())
-        return &it->second;
+    Entity& e = pool_[idx];
+    Sector& s = sectors_[e.sectorIndex];
+    e.sectorSlot = static_cast<std::uint32_t>(s.entities.size());
+    s.entities.push_back(idx);
 
-    auto [insIt, _] = sectors_.emplace(c, Sector{});
-    return &insIt->second;
+    if (e.isPlayer) {
+        e.playerSlot = static_cast<std::uint32_t>(s.players.size());
+        s.players.push_back(idx);
+    }
 }
 
-const AoiWorld::Sector* AoiWorld::get_sector(const AoiSectorCoord& c) const
+void AoiWorld::leave_sector(std::uint32_t idx)
 {
-    auto it = sectors_.find(c);
-    return (it == sectors_.end()) ? nullptr : &it->second;
+    Entity& e = pool_[idx];
+    Sector& s = sectors_[e.sectorIndex];
+
+    const std::uint32_t slot = e.sectorSlot;
+    const std::uint32_t last = s.entities.back();
+    s.entities[slot] = last;
+    pool_[last].sectorSlot = slot;
+    s.entities.pop_back();
+    e.sectorSlot = kInvalidIndex;
+
+    if (e.isPlayer) {
+        const std::uint32_t pslot = e.playerSlot;
+        const std::uint32_t plast = s.players.back();
+        s.players[pslot] = plast;
+        pool_[plast].playerSlot = pslot;
+        s.players.pop_back();
+        e.playerSlot = kInvalidIndex;
+    }
 }
 
-//--------------------------------------------
-// private: sector membership
-//--------------------------------------------
+void AoiWorld::add_watcher(std::uint32_t watcherIdx, int sx, int sy)
+{
+    Sector& s = sectors_[sector_index({ sx, sy })];
+    pool_[watcherIdx].watchSlots[window_slot_index(sx, sy)] = static_cast<std::uint32_t>(s.watchers.size());
+    s.watchers.push_back(watcherIdx);
+}
 
-void AoiWorld::enter_sector(std::uint64_t id, const AoiSectorCoord& c)
+void AoiWorld::remove_watcher(std::uint32_t watcherIdx, int sx, int sy)
 {
-    Sector* s = get_or_create_sector(c);
-    s->entities.insert(id);
+    Sector& s = sectors_[sector_index({ sx, sy })];
+    const std::uint32_t ws = window_slot_index(sx, sy);
+    const std::uint32_t slot = pool_[watcherIdx].watchSlots[ws];
+
+    const std::uint32_t last = s.watchers.back();
+    s.watchers[slot] = last;
+    // 자리를 옮긴 watcher 의 슬롯 번호도 갱신 (같은 섹터라 mod 인덱스도 같음)
+    pool_[last].watchSlots[ws] = slot;
+    pool_[watcherIdx].watchSlots[ws] = kInvalidIndex;
+    s.watchers.pop_back();
 }
 
-void AoiWorld::leave_sector(std::uint64_t id, const AoiSectorCoord& c)
+void AoiWorld::unsubscribe_all(std::uint32_t watcherIdx)
 {
-    auto it = sectors_.find(c);
-    if (it == sectors_.end())
-        return;
-    it->second.entities.erase(id);
+    Entity& e = pool_[watcherIdx];
+    if (!e.window.empty()) {
+        for (int sy = e.window.minY; sy <= e.window.maxY; ++sy) {
+            for (int sx = e.window.minX; sx <= e.window.maxX; ++sx) {
+                remove_watcher(watcherIdx, sx, sy);
+            }
+        }
+    }
+    e.watchSlots.clear();
+    e.window = AoiSectorRect{};
 }
 
 //--------------------------------------------
-// private: view sectors (player)
+// private: rebuild_player_subscriptions
 //--------------------------------------------
 
-void AoiWorld::collect_view_sectors(const Entity& e,
-    std::vector<AoiSectorCoord>& out) const
+void AoiWorld::rebuild_player_subscriptions(std::uint32_t idx)
 {
-    out.clear();
-    for (int dy = -viewRadius_; dy <= viewRadius_; ++dy) {
-        for (int dx = -viewRadius_; dx <= viewRadius_; ++dx) {
-            AoiSectorCoord sc{ e.sector.x + dx, e.sector.y + dy };
-            if (sc.x < 0 || sc.y < 0)
-                continue;
-            out.push_back(sc);
+    Entity& e = pool_[idx];
+
+    const AoiSectorRect oldWin = e.window;
+    const AoiSectorRect newWin = view_window(e.sector);
+
+    if (e.watchSlots.empty()) {
+        const int side = viewRadius_ * 2 + 1;
+        e.watchSlots.assign(static_cast<std::size_t>(side) * side, kInvalidIndex);
+    }
+
+    // 구독(후보 섹터)만 갱신. 실제 Enter/Leave 는 evaluate_watcher 가 거리로 판단
+    //  1) 빠지는 띠(oldWin - newWin): watcher 해제
+    for_each_rect_diff(oldWin, newWin, [&](int sx, int sy) {
+        remove_watcher(idx, sx, sy);
+    });
+
+    //  2) 들어오는 띠(newWin - oldWin): watcher 등록
+    for_each_rect_diff(newWin, oldWin, [&](int sx, int sy) {
+        add_watcher(idx, sx, sy);
+    });
+
+    e.window = newWin;
+}
+
+//--------------------------------------------
+// private: 거리 기반 가시성 평가
+//  - Enter: 안 보이던 쌍이 enter 반경 안으로
+//  - Leave: 보이던 쌍이 leave 반경 밖으로 (또는 구독 창 밖으로)
+//  - 그 사이 거리는 이전 상태 유지 (경계에서 Enter/Leave 반복 방지)
+//--------------------------------------------
+
+void AoiWorld::evaluate_subject(std::uint32_t idx, bool sendMove)
+{
+    const Entity& e = pool_[idx];
+    const AoiEvent moveEv = make_event(AoiEvent::Type::Move, e);
+
+    // 1) 이미 보고 있는 watcher (뒤에서부터: Leave 가 리스트를 스왑-삭제함)
+    for (std::size_t k = pairs_.watched_by(idx).size(); k-- > 0;) {
+        const std::uint32_t w = pairs_.pair(pairs_.watched_by(idx)[k]).watcher;
+        if (w == idx) continue;
+
+        const Entity& we = pool_[w];
+        const float d2 = dist2(we.pos, e.pos);
+        if (!we.window.contains(e.sector.x, e.sector.y) || d2 > leaveRadius2_) {
+            emit(w, idx, make_event(AoiEvent::Type::Leave, e));
+        }
+        else if (sendMove) {
+            emit_move(pairs_.watched_by(idx)[k], d2, moveEv);
+        }
+    }
+
+    // 2) 내 섹터를 구독 중인 후보 watcher 중 아직 안 보는 쪽
+    for (auto w : sectors_[e.sectorIndex].watchers) {
+        if (w == idx) continue;
+        if (pairs_.contains(w, idx)) continue;
+
+        if (dist2(pool_[w].pos, e.pos) <= enterRadius2_ && admit(w, idx))
+            emit(w, idx, make_event(AoiEvent::Type::Enter, e));
+    }
+
+    // 3) 플레이어는 자기 Move 도 받음 (양자화 위치가 그대로면 생략)
+    if (sendMove && e.isPlayer) {
+        const std::uint32_t selfPair = pairs_.find(idx, idx);
+        if (selfPair != AoiPairIndex::kInvalid && client_in_sync(selfPair, e))
+            ++suppressedMoves_;
+        else
+            emit(idx, idx, moveEv);
+    }
+}
+
+void AoiWorld::evaluate_watcher(std::uint32_t idx)
+{
+    Entity& e = pool_[idx];
+    e.evalPos = e.pos;
+
+    // 1) 보고 있던 대상 중 멀어진 것 Leave
+    for (std::size_t k = pairs_.watching(idx).size(); k-- > 0;) {
+        const std::uint32_t s = pairs_.pair(pairs_.watching(idx)[k]).subject;
+        if (s == idx) continue;
+
+        const Entity& o = pool_[s];
+        if (!e.window.contains(o.sector.x, o.sector.y) || dist2(e.pos, o.pos) > leaveRadius2_)
+            emit(idx, s, make_event(AoiEvent::Type::Leave, o));
+    }
+
+    // 상한: 핸드오프 등으로 넘쳤으면 최하부터 정리하고, 최하 점수 캐시를 다시 계산
+    if (vis_.maxVisible > 0) {
+        std::uint32_t worst = find_worst(idx);
+        while (visible_count(idx) > vis_.maxVisible && worst != AoiPairIndex::kInvalid) {
+            const std::uint32_t s = pairs_.pair(worst).subject;
+            emit(idx, s, make_event(AoiEvent::Type::Leave, pool_[s]));
+            mark_crowded(idx);
+            worst = find_worst(idx);
+        }
+    }
+
+    // 2) 구독 창 안에서 enter 반경에 들어온 것 Snapshot
+    for (int sy = e.window.minY; sy <= e.window.maxY; ++sy) {
+        for (int sx = e.window.minX; sx <= e.window.maxX; ++sx) {
+            for (auto other : sectors_[sector_index({ sx, sy })].entities) {
+                if (other == idx) continue;
+                if (pairs_.contains(idx, other)) continue;
+
+                const Entity& o = pool_[other];
+                if (dist2(e.pos, o.pos) <= enterRadius2_ && admit(idx, other))
+                    emit(idx, other, make_event(AoiEvent::Type::Snapshot, o));
+            }
         }
     }
 }
 
 //--------------------------------------------
-// private: rebuild_player_subscriptions
+// private: emit
 //--------------------------------------------
 
-void AoiWorld::rebuild_player_subscriptions(Entity& e)
+void AoiWorld::emit(std::uint32_t watcherIdx, std::uint32_t subjectIdx, const AoiEvent& evIn)
 {
-    // 1)     
-    std::vector<AoiSectorCoord> viewSectors;
-    collect_view_sectors(e, viewSectors);
+    // 클라로 나가는 위치는 전부 양자화 값 (쌍 기준값과 같은 격자)
+    AoiEvent ev = evIn;
+    ev.position = quantize(evIn.position);
+
+    // 가시 쌍 갱신: Leave 면 끊고, 나머지는 (없으면) 연결
+    if (ev.type == AoiEvent::Type::Leave) {
+        const std::uint32_t pairId = pairs_.find(watcherIdx, subjectIdx);
+        if (pairId != AoiPairIndex::kInvalid) {
+            pairState_[pairId].pending = false;
+            pairState_[pairId].priority = 0.0f;
+            pairs_.erase(watcherIdx, subjectIdx);
+        }
+    }
+    else {
+        const std::uint32_t pairId = pairs_.insert(watcherIdx, subjectIdx);
+        if (pairId >= pairState_.size())
+            pairState_.resize(pairId + 1);
+
+        // 보낸 위치 기록 (Enter/Snapshot/Move 모두 클라 위치를 갱신함)
+        PairState& st = pairState_[pairId];
+        if (ev.type != AoiEvent::Type::Move)
+            st.tier = lod_tier(dist2(pool_[watcherIdx].pos, ev.position));
+        st.lastSentPos = ev.position;
+        st.lastSentVel = ev.velocity;
+        st.lastSentFrame = frame_;
+        st.pending = false;
+        st.priority = 0.0f;
+    }
 
-    std::unordered_set<AoiSectorCoord, AoiSectorCoord::Hasher> newSet(
-        viewSectors.begin(), viewSectors.end()
-    );
+    if (budget_.bytesPerFrame > 0)
+        charge(watcherIdx, ev.type);
 
-    // 2) /߰ diff
-    std::vector<AoiSectorCoord> toRemove;
-    std::vector<AoiSectorCoord> toAdd;
+    events_.push(pool_[watcherIdx].id, ev);
+}
+
+AoiWorld::LodTier AoiWorld::lod_tier(float distance2) const
+{
+    if (lod_.nearRadius <= 0.0f || distance2 <= lodNear2_)
+        return LodTier::Near;
+    if (distance2 <= lodMid2_)
+        return LodTier::Mid;
+    return LodTier::Far;
+}
+
+std::uint32_t AoiWorld::lod_interval(LodTier tier) const
+{
+    switch (tier) {
+    case LodTier::Near: return 1;
+    case LodTier::Mid:  return lod_.midInterval;
+    default:            return lod_.farMaxInterval;
+    }
+}
 
-    for (const auto& oldSc : e.subscribed) {
-        if (newSet.find(oldSc) == newSet.end())
-            toRemove.push_back(oldSc);
+void AoiWorld::emit_move(std::uint32_t pairId, float distance2, const AoiEvent& moveEv)
+{
+    PairState& st = pairState_[pairId];
+    st.tier = lod_tier(distance2);
+
+    // 클라가 가진 기준값(+외삽)과 맞으면 보낼 게 없음
+    //  (제자리 몬스터, 양자화 격자 안 미세 이동, 직선 이동 중)
+    if (client_in_sync(pairId, pool_[pairs_.pair(pairId).subject])) {
+        ++suppressedMoves_;
+        st.pending = false;
+        return;
     }
-    for (const auto& newSc : newSet) {
-        if (e.subscribed.find(newSc) == e.subscribed.end())
-            toAdd.push_back(newSc);
+
+    // 예산 모드: 틱 끝 스케줄에 맡김
+    if (budget_.bytesPerFrame > 0) {
+        if (!st.pending) {
+            st.pending = true;
+            pending_.push_back(pairId);
+        }
+        return;
     }
 
-    // 3) watchers 
-    for (const auto& sc : toRemove) {
-        auto it = sectors_.find(sc);
-        if (it == sectors_.end()) continue;
+    bool due = (frame_ - st.lastSentFrame) >= lod_interval(st.tier);
+    if (!due && st.tier == LodTier::Far)
+        due = dist2(moveEv.position, st.lastSentPos) >= lodFarMove2_;
 
-        // watcher  , ¥  ̰ Ǵ ƼƼ Leave 
-        if (sendCb_) {
-            for (auto otherId : it->second.entities) {
-                if (otherId == e.id) continue;
+    // Near 는 같은 틱 안 여러 번 이동도 그대로 (flush 에서 마지막 것만 남음)
+    if (due || st.tier == LodTier::Near) {
+        const AoiPairIndex::Pair& p = pairs_.pair(pairId);
+        emit(p.watcher, p.subject, moveEv);
+        return;
+    }
 
-                const Entity* other = get_entity(otherId);
-                if (!other) continue;
+    ++deferredMoves_;
+    if (!st.pending) {
+        st.pending = true;
+        pending_.push_back(pairId);
+    }
+}
 
-                // ? other  Ͱ  (newSet)    => Leave 
-                if (newSet.find(other->sector) != newSet.end())
-                    continue;
+void AoiWorld::advance_frame()
+{
+    ++frame_;
+
+    // 상한 때문에 밀려난 후보가 있는 watcher 는 주기적으로 다시 순위 매김
+    //  (자리가 비었거나, 보이던 것들이 멀어져 캐시된 최하 점수가 낡았을 수 있음)
+    if (vis_.maxVisible > 0 && !crowded_.empty() && frame_ % vis_.rerankInterval == 0) {
+        std::vector<std::uint32_t> rerank;
+        rerank.swap(crowded_);
+        for (auto w : rerank) {
+            Entity& we = pool_[w];
+            if (!we.alive || !we.isPlayer || !we.crowded)
+                continue;   // 이미 처리했거나 사라짐
+            we.crowded = false;
+            evaluate_watcher(w);    // 다시 밀려나면 crowded_ 에 재등록됨
+        }
+    }
 
-                AoiEvent ev;
-                ev.type = AoiEvent::Type::Leave;
-                ev.subjectId = otherId;
-                ev.position = other->pos;
-                sendCb_(e.id, ev);
-            }
+    if (budget_.bytesPerFrame > 0) {
+        schedule_moves();
+        return;
+    }
+
+    // 주기가 된 pending 쌍은 현재 위치로 Move 한 번
+    std::size_t keep = 0;
+    for (std::size_t i = 0; i < pending_.size(); ++i) {
+        const std::uint32_t pairId = pending_[i];
+        PairState& st = pairState_[pairId];
+        if (!st.pending)
+            continue; // 이미 보냈거나 Leave 된 쌍
+
+        if ((frame_ - st.lastSentFrame) < lod_interval(st.tier)) {
+            pending_[keep++] = pairId;
+            continue;
         }
 
-        it->second.watchers.erase(e.id);
+        const AoiPairIndex::Pair& p = pairs_.pair(pairId);
+        st.pending = false;
+        if (client_in_sync(pairId, pool_[p.subject])) {
+            ++suppressedMoves_;   // 미뤄진 사이 클라 상태와 다시 맞아짐
+            continue;
+        }
+        emit(p.watcher, p.subject, make_event(AoiEvent::Type::Move, pool_[p.subject]));
     }
+    pending_.resize(keep);
+}
 
+void AoiWorld::charge(std::uint32_t watcherIdx, AoiEvent::Type type)
+{
+    if (watcherIdx >= spent_.size())
+        spent_.resize(pool_.size(), 0);
+
+    std::uint32_t bytes = budget_.moveBytes;
+    if (type == AoiEvent::Type::Enter || type == AoiEvent::Type::Snapshot)
+        bytes = budget_.enterBytes;
+    else if (type == AoiEvent::Type::Leave)
+        bytes = budget_.leaveBytes;
+    spent_[watcherIdx] += bytes;
+}
 
-    for (const auto& sc : toAdd) {
-        Sector* s = get_or_create_sector(sc);
-        s->watchers.insert(e.id);
+void AoiWorld::schedule_moves()
+{
+    // 1) pending 쌍 우선순위 누적 (이미 맞아진 쌍은 제외)
+    schedule_.clear();
+    for (auto pairId : pending_) {
+        PairState& st = pairState_[pairId];
+        if (!st.pending)
+            continue;   // Leave 됐거나 중간에 보냄
+        st.pending = false;
+
+        const AoiPairIndex::Pair& p = pairs_.pair(pairId);
+        if (client_in_sync(pairId, pool_[p.subject])) {
+            ++suppressedMoves_;
+            st.priority = 0.0f;
+            continue;
+        }
 
-        //     ƼƼ  Snapshot ̺Ʈ 
-        if (sendCb_) {
-            for (auto otherId : s->entities) {
-                if (otherId == e.id) continue;
+        // LOD 구간 주기의 역수 = 틱당 증가량 (Near 1, Mid 1/midInterval, Far 1/farMaxInterval)
+        float rate = 1.0f / static_cast<float>(lod_interval(st.tier));
+        if (pool_[p.watcher].focusId == pool_[p.subject].id)
+            rate *= budget_.focusBoost;
+        st.priority += rate;
 
-                if (const Entity* other = get_entity(otherId)) {
-                    AoiEvent ev;
-                    ev.type = AoiEvent::Type::Snapshot;
-                    ev.subjectId = other->id;
-                    ev.position = other->pos;
+        schedule_.push_back(ScheduledMove{ p.watcher, st.priority, pairId });
+    }
+    pending_.clear();
 
-                    sendCb_(e.id, ev);
-                }
-            }
+    // 2) watcher 별 우선순위 높은 순으로 남은 예산만큼 전송, 나머지는 다음 틱으로
+    std::sort(schedule_.begin(), schedule_.end(), [](const ScheduledMove& a, const ScheduledMove& b) {
+        return a.watcher != b.watcher ? a.watcher < b.watcher : a.priority > b.priority;
+    });
+
+    if (spent_.size() < pool_.size())
+        spent_.resize(pool_.size(), 0);
+
+    for (const ScheduledMove& m : schedule_) {
+        const AoiPairIndex::Pair& p = pairs_.pair(m.pairId);
+        if (spent_[m.watcher] + budget_.moveBytes <= budget_.bytesPerFrame) {
+            emit(p.watcher, p.subject, make_event(AoiEvent::Type::Move, pool_[p.subject]));
+            continue;
         }
+
+        ++budgetDeferred_;
+        PairState& st = pairState_[m.pairId];
+        st.pending = true;
+        pending_.push_back(m.pairId);
     }
 
-    // 4) ÷̾    ֽȭ
-    e.subscribed = std::move(newSet);
+    // 다음 틱 예산
+    std::fill(spent_.begin(), spent_.end(), 0);
+}
+
+float AoiWorld::visibility_score(const Entity& watcher, const Entity& subject) const
+{
+    if (watcher.focusId != 0 && watcher.focusId == subject.id)
+        return -1.0f;
+    return dist2(watcher.pos, subject.pos) * (subject.playerKind ? vis_.playerWeight : vis_.npcWeight);
+}
+
+std::size_t AoiWorld::visible_count(std::uint32_t watcherIdx) const
+{
+    const std::size_t n = pairs_.watching(watcherIdx).size();
+    return (n > 0 && pairs_.contains(watcherIdx, watcherIdx)) ? n - 1 : n;
+}
+
+std::uint32_t AoiWorld::find_worst(std::uint32_t watcherIdx)
+{
+    Entity& we = pool_[watcherIdx];
+    std::uint32_t worst = AoiPairIndex::kInvalid;
+    float worstScore = -1.0f;
+
+    for (auto pairId : pairs_.watching(watcherIdx)) {
+        const std::uint32_t s = pairs_.pair(pairId).subject;
+        if (s == watcherIdx)
+            continue;
+        const float score = visibility_score(we, pool_[s]);
+        if (worst == AoiPairIndex::kInvalid || score > worstScore) {
+            worst = pairId;
+            worstScore = score;
+        }
+    }
+
+    we.worstScore = worstScore;
+    return worst;
+}
+
+bool AoiWorld::admit(std::uint32_t watcherIdx, std::uint32_t subjectIdx)
+{
+    if (vis_.maxVisible == 0)
+        return true;
+
+    Entity& we = pool_[watcherIdx];
+    const float score = visibility_score(we, pool_[subjectIdx]);
+
+    if (visible_count(watcherIdx) < vis_.maxVisible) {
+        we.worstScore = std::max(we.worstScore, score);
+        return true;
+    }
+
+    // 캐시된 최하 점수로 먼저 거름 (몰린 상황에서 대부분 여기서 끝남)
+    //  - focus(-1) 는 항상 통과해서 실제 최하와 비교
+    if (score >= 0.0f && score * swapMargin2_ >= we.worstScore) {
+        ++crowdedOut_;
+        mark_crowded(watcherIdx);
+        return false;
+    }
+
+    const std::uint32_t worst = find_worst(watcherIdx);
+    if (worst == AoiPairIndex::kInvalid || score * swapMargin2_ >= we.worstScore) {
+        ++crowdedOut_;
+        mark_crowded(watcherIdx);
+        return false;
+    }
+
+    // 최하 쌍을 내보내고 자리 만듦 (내보낸 쪽이 다시 들어올 수 있게 crowded 표시)
+    const std::uint32_t s = pairs_.pair(worst).subject;
+    emit(watcherIdx, s, make_event(AoiEvent::Type::Leave, pool_[s]));
+    mark_crowded(watcherIdx);
+
+    find_worst(watcherIdx);
+    we.worstScore = std::max(we.worstScore, score);
+    return true;
+}
+
+void AoiWorld::mark_crowded(std::uint32_t watcherIdx)
+{
+    Entity& we = pool_[watcherIdx];
+    if (we.crowded)
+        return;
+    we.crowded = true;
+    crowded_.push_back(watcherIdx);
+}
+
+bool AoiWorld::is_watching(std::uint64_t watcherId, std::uint64_t subjectId) const
+{
+    const std::uint32_t w = find_index(watcherId);
+    const std::uint32_t s = find_index(subjectId);
+    if (w == kInvalidIndex || s == kInvalidIndex)
+        return false;
+    return pairs_.contains(w, s);
+}
+
+bool AoiObservedMask::test(const AoiVec2& pos) const
+{
+    if (sectors.empty())
+        return false;
+
+    // AoiWorld::world_to_sector 와 같은 규칙 (맵 밖은 가장자리 섹터)
+    const int sx = std::clamp(static_cast<int>(std::floor(pos.x / sectorSize)), 0, width - 1);
+    const int sy = std::clamp(static_cast<int>(std::floor(pos.y / sectorSize)), 0, height - 1);
+    return sectors[static_cast<std::size_t>(sy) * width + sx] != 0;
+}
+
+void AoiWorld::collect_observed(AoiObservedMask& out) const
+{
+    out.sectorSize = sectorSize_;
+    out.width = width_;
+    out.height = height_;
+    out.sectors.assign(sectors_.size(), 0);
+
+    for (std::size_t i = 0; i < sectors_.size(); ++i) {
+        if (!sectors_[i].watchers.empty())
+            out.sectors[i] = 1;
+    }
+    if (ghostPlayers_ == 0)
+        return;
+
+    // 바깥 플레이어는 여기서 구독하지 않으므로 플레이어 ghost 마다 같은 크기 창을 직접 표시
+    for (const Entity& o : pool_) {
+        if (!o.alive || !o.ghost || !o.playerKind)
+            continue;
+
+        const AoiSectorRect win = view_window(o.sector);
+        for (int sy = win.minY; sy <= win.maxY; ++sy) {
+            for (int sx = win.minX; sx <= win.maxX; ++sx)
+                out.sectors[sector_index({ sx, sy })] = 1;
+        }
+    }
+}
+
+std::size_t AoiWorld::watcher_count(std::uint64_t subjectId) const
+{
+    const std::uint32_t s = find_index(subjectId);
+    return (s == kInvalidIndex) ? 0 : pairs_.watched_by(s).size();
 }
 
 //--------------------------------------------
-// private: broadcast_to_sector_watchers
+// public: 공간 질의
 //--------------------------------------------
 
-void AoiWorld::broadcast_to_sector_watchers(const AoiSectorCoord& c,const AoiEvent& ev,std::int64_t excludeId)
+AoiSectorRect AoiWorld::sector_rect(float minX, float minY, float maxX, float maxY) const
 {
-    if (!sendCb_) return;
+    const AoiSectorCoord lo = world_to_sector({ minX, minY });
+    const AoiSectorCoord hi = world_to_sector({ maxX, maxY });
+    return AoiSectorRect{ lo.x, lo.y, hi.x, hi.y };
+}
 
-    auto it = sectors_.find(c);
-    if (it == sectors_.end())
-        return;
+std::size_t AoiWorld::query_nearest(const AoiVec2& center, float radius, std::size_t k,
+    AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const
+{
+    out.clear();
+    if (k == 0 || radius <= 0.0f)
+        return 0;
+
+    const float r2 = radius * radius;
+
+    // k == 1 (AI 타겟 탐색) 은 정렬 없이 최솟값만
+    if (k == 1) {
+        AoiQueryHit best;
+        best.dist2 = r2;
+        bool found = false;
+
+        for_each_in_rect(sector_rect(center.x - radius, center.y - radius, center.x + radius, center.y + radius),
+            filter, [&](const Entity& e) {
+                const float d2 = dist2(center, e.pos);
+                if (d2 <= best.dist2) {
+                    best.id = e.id;
+                    best.pos = e.pos;
+                    best.dist2 = d2;
+                    found = true;
+                }
+            });
+
+        if (found)
+            out.push_back(best);
+        return out.size();
+    }
 
-    for (auto watcherId : it->second.watchers) {
-        if (excludeId != 0 && watcherId == excludeId)
-            continue; //  
-        sendCb_(watcherId, ev);
+    query_circle(center, radius, filter, out);
+
+    auto byDist = [](const AoiQueryHit& a, const AoiQueryHit& b) { return a.dist2 < b.dist2; };
+    if (out.size() > k) {
+        std::partial_sort(out.begin(), out.begin() + k, out.end(), byDist);
+        out.resize(k);
+    }
+    else {
+        std::sort(out.begin(), out.end(), byDist);
     }
+    return out.size();
+}
+
+std::size_t AoiWorld::query_circle(const AoiVec2& center, float radius,
+    AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const
+{
+    out.clear();
+    if (radius <= 0.0f)
+        return 0;
+
+    const float r2 = radius * radius;
+    for_each_in_rect(sector_rect(center.x - radius, center.y - radius, center.x + radius, center.y + radius),
+        filter, [&](const Entity& e) {
+            const float d2 = dist2(center, e.pos);
+            if (d2 <= r2)
+                out.push_back(AoiQueryHit{ e.id, e.pos, d2 });
+        });
+    return out.size();
+}
+
+std::size_t AoiWorld::query_cone(const AoiVec2& origin, const AoiVec2& dir, float radius, float halfAngleRad,
+    AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const
+{
+    out.clear();
+    if (radius <= 0.0f)
+        return 0;
+
+    const float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+    if (len <= 0.0f)
+        return query_circle(origin, radius, filter, out);
+
+    const float ux = dir.x / len;
+    const float uy = dir.y / len;
+    const float cosHalf = std::cos(halfAngleRad);
+    const float r2 = radius * radius;
+
+    for_each_in_rect(sector_rect(origin.x - radius, origin.y - radius, origin.x + radius, origin.y + radius),
+        filter, [&](const Entity& e) {
+            const float dx = e.pos.x - origin.x;
+            const float dy = e.pos.y - origin.y;
+            const float d2 = dx * dx + dy * dy;
+            if (d2 > r2)
+                return;
+
+            // dot(u, d) >= |d| * cos(half)  (제곱 비교로 sqrt 없이)
+            const float dot = ux * dx + uy * dy;
+            if (d2 > 0.0f) {
+                if (cosHalf >= 0.0f) {
+                    if (dot < 0.0f || dot * dot < d2 * cosHalf * cosHalf)
+                        return;
+                }
+                else if (dot < 0.0f && dot * dot > d2 * cosHalf * cosHalf) {
+                    return;
+                }
+            }
+            out.push_back(AoiQueryHit{ e.id, e.pos, d2 });
+        });
+    return out.size();
 }
-static void collect_watchers(const AoiWorld::Sector* s, std::vector<uint64_t>& out)
+
+std::size_t AoiWorld::query_segment(const AoiVec2& from, const AoiVec2& to, float halfWidth,
+    AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const
 {
     out.clear();
-    if (!s) return;
-    out.reserve(s->watchers.size());
-    for (auto w : s->watchers) out.push_back(w);
-}
\ No newline at end of file
+
+    const float w = std::max(halfWidth, 0.0f);
+    const float w2 = w * w;
+    const float sx = to.x - from.x;
+    const float sy = to.y - from.y;
+    const float segLen2 = sx * sx + sy * sy;
+
+    for_each_in_rect(sector_rect(std::min(from.x, to.x) - w, std::min(from.y, to.y) - w,
+        std::max(from.x, to.x) + w, std::max(from.y, to.y) + w),
+        filter, [&](const Entity& e) {
+            const float px = e.pos.x - from.x;
+            const float py = e.pos.y - from.y;
+
+            // 선분 위 최근접점 파라미터 t (0~1)
+            float t = 0.0f;
+            if (segLen2 > 0.0f)
+                t = std::clamp((px * sx + py * sy) / segLen2, 0.0f, 1.0f);
+
+            const float cx = px - t * sx;
+            const float cy = py - t * sy;
+            if (cx * cx + cy * cy <= w2)
+                out.push_back(AoiQueryHit{ e.id, e.pos, px * px + py * py });
+        });
+    return out.size();
+}
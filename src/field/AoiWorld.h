@@ -3,12 +3,12 @@
 
 #include <cstdint>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
-#include <functional>
+
+#include "AoiPairIndex.h"
 
 // =======================
-// ⺻ ŸԵ
+// 기본 타입들
 // =======================
 
 struct AoiVec2
@@ -25,116 +25,540 @@ struct AoiSectorCoord
     bool operator==(const AoiSectorCoord& other) const noexcept {
         return x == other.x && y == other.y;
     }
+};
 
-    struct Hasher {
-        std::size_t operator()(const AoiSectorCoord& s) const noexcept {
-            return (static_cast<std::size_t>(s.x) << 32)
-                ^ static_cast<std::size_t>(s.y);
-        }
-    };
+// 섹터 좌표 사각형 (양 끝 포함). 플레이어 구독 창(window) 표현용
+struct AoiSectorRect
+{
+    int minX = 0;
+    int minY = 0;
+    int maxX = -1;
+    int maxY = -1;
+
+    bool contains(int x, int y) const noexcept {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY;
+    }
+    bool empty() const noexcept { return maxX < minX || maxY < minY; }
 };
 
-// AOI ̺Ʈ Ÿ: Ʈũ Ŷ ϸ 
+// AOI 이벤트 타입: 네트워크 패킷으로 매핑하면 됨
 struct AoiEvent
 {
     enum class Type
     {
-        Enter,      //  ƼƼ  þ߿  
-        Leave,      //  þ߿ 
-        Move,       //  þ ȿ ̵
-        Snapshot    //    ʱ 
+        Enter,      // 어떤 엔티티가 내 시야에 새로 등장
+        Leave,      // 내 시야에서 사라짐
+        Move,       // 내 시야 안에서 이동
+        Snapshot    // 새로 구독한 섹터의 초기 스냅샷
     };
 
     Type          type{};
-    std::uint64_t subjectId = 0; // ȭ Ͼ ƼƼ ID
-    AoiVec2       position{};    // ġ
+    std::uint64_t subjectId = 0; // 변화가 일어난 엔티티 ID
+    AoiVec2       position{};    // 위치
+    AoiVec2       velocity{};    // 속도 (m/s, dead reckoning 켰을 때만. 클라는 다음 Move 까지 외삽)
+};
+
+// 틱 동안 쌓이는 AOI 이벤트 (struct-of-arrays)
+//  - AoiWorld 는 이벤트를 바로 보내지 않고 여기에 append 만 함
+//  - FieldAoiSystem 이 틱 끝에 watcher 별로 정렬/중복 제거 후 한 번에 소비
+struct AoiEventBuffer
+{
+    std::vector<std::uint64_t>  watcher;
+    std::vector<std::uint64_t>  subject;
+    std::vector<AoiEvent::Type> type;
+    std::vector<AoiVec2>        position;
+    std::vector<AoiVec2>        velocity;
+
+    void push(std::uint64_t watcherId, const AoiEvent& ev)
+    {
+        watcher.push_back(watcherId);
+        subject.push_back(ev.subjectId);
+        type.push_back(ev.type);
+        position.push_back(ev.position);
+        velocity.push_back(ev.velocity);
+    }
+
+    AoiEvent at(std::size_t i) const
+    {
+        AoiEvent ev;
+        ev.type = type[i];
+        ev.subjectId = subject[i];
+        ev.position = position[i];
+        ev.velocity = velocity[i];
+        return ev;
+    }
+
+    std::size_t size() const { return watcher.size(); }
+    bool        empty() const { return watcher.empty(); }
+
+    // capacity 는 유지 (틱마다 재할당 안 함)
+    void clear()
+    {
+        watcher.clear();
+        subject.clear();
+        type.clear();
+        position.clear();
+        velocity.clear();
+    }
+
+    void swap(AoiEventBuffer& o) noexcept
+    {
+        watcher.swap(o.watcher);
+        subject.swap(o.subject);
+        type.swap(o.type);
+        position.swap(o.position);
+        velocity.swap(o.velocity);
+    }
+};
+
+
+// 공간 질의 결과 한 개
+struct AoiQueryHit
+{
+    std::uint64_t id = 0;
+    AoiVec2       pos{};
+    float         dist2 = 0.0f;  // 질의 기준점까지 거리 제곱
+};
+
+enum class AoiQueryFilter : std::uint8_t
+{
+    All,
+    Players,
+    NonPlayers,
+};
+
+// Move 전송 빈도 LOD (watcher-subject 쌍 거리 기준)
+//  - Near: 매 틱, Mid: midInterval 틱마다, Far: farMinMove 이상 움직였거나 farMaxInterval 틱 경과 시
+//  - 건너뛴 Move 는 쌍에 pending 으로 남았다가 주기가 되면 최신 위치로 한 번 보냄
+//  - nearRadius <= 0 이면 LOD 끔 (전부 Near)
+struct AoiLodParams
+{
+    float         nearRadius = 0.0f;
+    float         midRadius = 0.0f;
+    std::uint32_t midInterval = 3;      // 틱
+    float         farMinMove = 1.5f;    // m
+    std::uint32_t farMaxInterval = 20;  // 틱
+};
+
+// watcher 별 가시 엔티티 상한 (같은 자리에 수백 명이 몰릴 때 O(n²) 팬아웃 방지)
+//  - 후보 점수 = 거리² x 종류 가중치 (작을수록 우선), watcher 의 focus(타겟)는 항상 최우선
+//  - 꽉 찬 상태에서 새 후보는 보이는 것 중 최하보다 swapMargin 배 이상 가까워야 교체 (깜빡임 방지)
+//  - 밀려난 후보가 있는 watcher 는 rerankInterval 틱마다 다시 순위를 매김
+//  - maxVisible == 0 이면 끔
+struct AoiVisibilityParams
+{
+    std::uint32_t maxVisible = 0;
+    float         playerWeight = 1.0f;
+    float         npcWeight = 1.0f;
+    float         swapMargin = 1.2f;       // 거리 비율
+    std::uint32_t rerankInterval = 10;     // 틱
+};
+
+// watcher 별 송신 바이트 예산 (틱 단위)
+//  - Enter/Leave/Snapshot 과 자기 Move 는 바로 나가고 예산에서 차감만 됨
+//  - 다른 엔티티 Move 는 쌍마다 우선순위를 누적 (LOD 구간 빈도 x focus 가중치)
+//    틱 끝에 watcher 별로 높은 순서대로 남은 예산만큼 보내고 보낸 쌍은 0 으로 리셋
+//    -> 못 보낸 쌍은 계속 쌓여서 결국 나감 (오래 안 갱신된 엔티티도 언젠가 보정됨)
+//  - 켜면 LOD 의 고정 주기 대신 이 스케줄이 Move 빈도를 정함
+//  - bytesPerFrame == 0 이면 끔
+//  - *Bytes: 프레임 헤더 포함 대략적인 FieldCmd 크기
+struct AoiSendBudget
+{
+    std::uint32_t bytesPerFrame = 0;
+    std::uint32_t moveBytes = 64;
+    std::uint32_t enterBytes = 96;
+    std::uint32_t leaveBytes = 40;
+    float         focusBoost = 4.0f;
 };
 
-// watcherId(÷̾) ev  ݹ
-using AoiSendCallback = std::function<void(std::uint64_t watcherId,
-    const AoiEvent& ev)>;
+// 관찰 중인 섹터 스냅샷 (collect_observed)
+//  - 어떤 플레이어 구독 창 안이거나, 인접 리전 플레이어 ghost 의 창 안인 섹터
+//  - 몬스터 스텝마다 한 번 만들고 몬스터별로는 test 만 (AOI 락을 몬스터마다 잡지 않도록)
+struct AoiObservedMask
+{
+    float                     sectorSize = 1.0f;
+    int                       width = 0;
+    int                       height = 0;
+    std::vector<std::uint8_t> sectors;      // 1 = 관찰 중
 
+    bool test(const AoiVec2& pos) const;
+};
 
 // =======================
-// AOI 
+// AOI 월드
 // =======================
 
 class AoiWorld
 {
 public:
-    // ƼƼ   (÷̾/ )
+    static constexpr std::uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    // 엔티티 한 개 (플레이어/몬스터 등)
+    //  - pool_ 에 밀집 저장, 섹터에는 pool 인덱스만 들어감
     struct Entity
     {
         std::uint64_t id = 0;
         bool          isPlayer = false;
+        bool          alive = false;
+        bool          ghost = false;                // 인접 리전 소유 엔티티의 복제본 (subject 전용)
+        bool          playerKind = false;           // 실제 종류 (ghost 플레이어도 true, 가시 우선순위용)
 
         AoiVec2       pos{};
+        AoiVec2       vel{};                        // dead reckoning 용 속도 (켰을 때만 갱신)
+        AoiVec2       evalPos{};                    // 마지막 watcher 쪽 평가 위치 (플레이어)
         AoiSectorCoord sector{};
+        std::uint32_t sectorIndex = 0;              // x + y * width
+        std::uint32_t sectorSlot = kInvalidIndex;   // sectors_[sectorIndex].entities 내 위치
+        std::uint32_t playerSlot = kInvalidIndex;   // sectors_[sectorIndex].players 내 위치 (플레이어)
+
+        // 플레이어일 때만 사용: 구독 중인 섹터 창과 각 섹터 watchers 내 위치
+        //  - watchSlots 는 (sx mod side, sy mod side) 인덱스 ((2r+1)^2 고정 크기)
+        //    창이 이동해도 남는 섹터의 슬롯은 자리 그대로라 재배치가 필요 없음
+        AoiSectorRect              window{};
+        std::vector<std::uint32_t> watchSlots;
 
-        // ÷̾  :     
-        std::unordered_set<AoiSectorCoord, AoiSectorCoord::Hasher> subscribed;
+        // 가시 상한 (플레이어)
+        std::uint64_t focusId = 0;      // 현재 타겟: 상한과 무관하게 항상 보임
+        float         worstScore = 0.0f; // 보이는 것 중 최하 점수 (캐시, 재순위 때 다시 계산)
+        bool          crowded = false;   // 상한 때문에 못 들어온 후보가 있음
     };
 
-    //   ĭ
+    enum class LodTier : std::uint8_t { Near = 0, Mid, Far };
+
+    // 가시 쌍 하나의 상태 (pair id 로 인덱싱)
+    struct PairState
+    {
+        AoiVec2       lastSentPos{};            // 클라가 마지막으로 받은 위치 (양자화 값, 델타 기준)
+        AoiVec2       lastSentVel{};            // 클라가 외삽에 쓰는 속도
+        std::uint32_t lastSentFrame = 0;
+        LodTier       tier = LodTier::Near;
+        bool          pending = false;   // 보내지 않은 Move 가 있음
+        float         priority = 0.0f;   // 송신 예산 스케줄용 누적 우선순위
+    };
+
+    // 섹터 한 칸: 스왑-삭제 벡터 (순서 의미 없음)
     struct Sector
     {
-        std::unordered_set<std::uint64_t> entities; //  Ϳ ִ ƼƼ IDs
-        std::unordered_set<std::uint64_t> watchers; //  ͸   ÷̾ IDs
+        std::vector<std::uint32_t> entities; // 이 섹터에 있는 엔티티 (pool 인덱스)
+        std::vector<std::uint32_t> players;  // entities 중 플레이어만 (질의용)
+        std::vector<std::uint32_t> watchers; // 이 섹터를 구독 중인 플레이어 (pool 인덱스)
     };
 
 public:
-    // sectorSize:    (: 5m, 10m)
-    // viewRadiusSectors: AOI ݰ (1̸ 3x3, 2 5x5)
-    explicit AoiWorld(float sectorSize, int viewRadiusSectors);
+    // sectorSize: 한 섹터의 길이 (예: 5m, 10m)
+    // viewRadiusSectors: AOI 반경 (1이면 3x3, 2면 5x5)
+    // worldWidth/Height: 필드 크기 (이 범위로 섹터 배열을 미리 할당, 밖은 가장자리 섹터로 클램프)
+    AoiWorld(float sectorSize, int viewRadiusSectors, float worldWidth, float worldHeight);
+
+    // 원형 관심 반경 (m). enter < leave 로 두면 경계에서 Enter/Leave 가 튀지 않음
+    //  - leave 는 구독 창이 덮는 거리(sectorSize * viewRadius)로 잘림
+    //  - 0 이하면 창 거리 전체
+    //  - 엔티티 등록 전에 설정
+    void set_interest_radius(float enterRadius, float leaveRadius);
+    void set_lod(const AoiLodParams& lod);
+
+    // 전송 위치 양자화 간격 (m). 쌍마다 마지막으로 보낸 양자화 위치(기준값)와 같으면 Move 생략
+    //  - 0 이하면 끔 (float 그대로, 완전히 같은 위치만 생략)
+    void set_move_quantization(float step);
+
+    // dead reckoning: 클라가 마지막 (위치, 속도)로 외삽한다고 보고
+    //  출발/정지/방향·속도 변경, 외삽 오차 > errorM, 움직이는 중 refreshFrames 경과 때만 Move
+    //  - errorM <= 0 이면 끔 (속도 안 보냄, 위치가 바뀔 때마다 Move)
+    //  - frameSec: advance_frame 한 번의 시간 (필드 틱)
+    void set_dead_reckoning(float errorM, std::uint32_t refreshFrames, float frameSec);
+
+    // watcher 별 가시 상한 (엔티티 등록 전에 설정)
+    void set_visibility_cap(const AoiVisibilityParams& vis);
+
+    // watcher 의 현재 타겟 (0 = 해제). 상한이 꽉 차 있어도 최하 쌍을 밀어내고 보이게 함
+    void set_focus(std::uint64_t watcherId, std::uint64_t subjectId);
 
-    void set_send_callback(AoiSendCallback cb) { sendCb_ = std::move(cb); }
+    // watcher 별 틱당 송신 예산
+    void set_send_budget(const AoiSendBudget& budget);
 
-    // ƼƼ /
+    // 틱 경계 (flush 직전 1회): 주기가 된 pending Move 를 현재 위치로 기록
+    void advance_frame();
+    std::uint64_t deferred_moves() const { return deferredMoves_; }
+    std::uint64_t suppressed_moves() const { return suppressedMoves_; }
+    std::uint64_t crowded_out() const { return crowdedOut_; }
+    std::uint64_t budget_deferred() const { return budgetDeferred_; }
+
+    // 지금까지 발생한 AOI 이벤트 (소비 측에서 swap/clear)
+    AoiEventBuffer&       events() { return events_; }
+    const AoiEventBuffer& events() const { return events_; }
+
+    // 엔티티 등록/제거
     void add_entity(std::uint64_t id, bool isPlayer, const AoiVec2& pos);
     void remove_entity(std::uint64_t id);
 
-    // ġ  ( ȿ  ̵ + ÷̾ AOI ű)
+    // 위치 갱신 (맵 안에서 실제 이동 + 플레이어면 AOI 구독까지)
+    //  - velocity 없는 쪽은 정지/순간이동으로 봄 (속도 0)
     void move_entity(std::uint64_t id, const AoiVec2& newPos);
+    void move_entity(std::uint64_t id, const AoiVec2& newPos, const AoiVec2& velocity);
+
+    // ----- 리전 경계 (한 필드를 여러 워커가 나눠 가질 때) -----
+    //  - ghost: 인접 리전이 소유한 엔티티의 복제본. 이 리전 watcher 에게 보이기만 하고
+    //    자기 시야(watcher)는 없으며 공간 질의에서도 빠짐. 위치는 move_entity 로 갱신
+    //  - playerKind: 원래 플레이어인지 (가시 우선순위 가중치용)
+    void add_ghost(std::uint64_t id, const AoiVec2& pos, bool playerKind = false);
+    bool is_ghost(std::uint64_t id) const;
+    // 인접 리전 플레이어 ghost 수 (이 리전을 보고 있을 수 있는 바깥 플레이어)
+    std::size_t ghost_players() const { return ghostPlayers_; }
+
+    // 소유 플레이어 -> ghost (다른 리전으로 핸드오프할 때)
+    //  - 나를 보던 쌍은 그대로 (이 리전 watcher 는 계속 봄), 내가 보던 쌍은 이벤트 없이 끊음
+    //  - visibleOut: 끊기 전에 보고 있던 subject id (새 소유 리전이 중복 Enter 를 안 보내도록)
+    bool demote_to_ghost(std::uint64_t id, std::vector<std::uint64_t>& visibleOut);
 
-    // ÷̾ AOI  ϰ   (tick ȣ )
+    // 핸드오프로 넘어온 플레이어 등록 (ghost 로 있었으면 그대로 승격)
+    //  - visible 은 클라가 이미 보고 있다고 보고 Snapshot 대신 Move, 여기 없거나 멀면 Leave
+    void adopt_player(std::uint64_t id, const AoiVec2& pos, const std::vector<std::uint64_t>& visible);
+
+    // 이 리전 소유 엔티티 전부 (ghost 제외) fn(const Entity&)
+    template <typename Fn>
+    void for_each_owned(Fn&& fn) const;
+
+    // 플레이어의 AOI를 강제 재계산하고 싶을 때 (tick에서 호출 가능)
     void update_player_aoi(std::uint64_t playerId);
 
     const Entity* get_entity(std::uint64_t id) const;
     Entity* get_entity(std::uint64_t id);
 
+    // 가시 쌍 조회 (이벤트 기준: Enter/Snapshot/Move 받은 뒤 Leave 전까지)
+    //  - 플레이어는 자기 Move 를 받으므로 자기 자신도 watcher 로 잡힘
+    bool        is_watching(std::uint64_t watcherId, std::uint64_t subjectId) const;
+    // 플레이어 구독 창 안인 섹터 전부 (인접 리전 플레이어 ghost 근처 포함)
+    //  - 아닌 곳의 엔티티는 아무 클라에도 안 보이고, 곧 보일 일도 없음
+    void        collect_observed(AoiObservedMask& out) const;
+    std::size_t watcher_count(std::uint64_t subjectId) const;
+
+    template <typename Fn>
+    void for_each_watcher(std::uint64_t subjectId, Fn&& fn) const;
+
+    // ----- 공간 질의 (섹터 그리드 재사용) -----
+    //  - out 은 비우고 채움, 반환값 = 결과 개수
+    //  - 가까운 순 정렬은 query_nearest 만 보장
+
+    // center 에서 radius 안 가장 가까운 k 개
+    std::size_t query_nearest(const AoiVec2& center, float radius, std::size_t k,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const;
+
+    // 원 안 전부
+    std::size_t query_circle(const AoiVec2& center, float radius,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const;
+
+    // 부채꼴: dir 방향(정규화 불필요) 기준 좌우 halfAngleRad, 반경 radius
+    std::size_t query_cone(const AoiVec2& origin, const AoiVec2& dir, float radius, float halfAngleRad,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const;
+
+    // 선분 from->to 에서 halfWidth 이내 (돌진/관통 스킬). dist2 는 from 기준
+    std::size_t query_segment(const AoiVec2& from, const AoiVec2& to, float halfWidth,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out) const;
+
 private:
-    using EntityMap = std::unordered_map<std::uint64_t, Entity>;
-    using SectorMap = std::unordered_map<AoiSectorCoord, Sector, AoiSectorCoord::Hasher>;
+    std::vector<Entity>        pool_;       // 밀집 엔티티 저장소
+    std::vector<std::uint32_t> freeSlots_;  // 재사용 가능한 pool 인덱스
+    std::unordered_map<std::uint64_t, std::uint32_t> index_; // id -> pool 인덱스
 
-    EntityMap entities_;
-    SectorMap sectors_;
+    std::vector<Sector> sectors_;           // width_ * height_ 미리 할당
 
     float sectorSize_ = 1.0f;
-    int   viewRadius_ = 1; //   ݰ
+    int   viewRadius_ = 1; // 섹터 단위 반경 (후보 섹터)
+    float enterRadius2_ = 0.0f;
+    float leaveRadius2_ = 0.0f;
+    float reevalDist2_ = 0.0f;
+    int   width_ = 1;      // 섹터 개수 (x)
+    int   height_ = 1;     // 섹터 개수 (y)
 
-    AoiSendCallback sendCb_;
+    AoiEventBuffer events_;
+    AoiPairIndex   pairs_;     // watcher <-> subject (pool 인덱스)
+
+    // LOD
+    AoiLodParams               lod_{};
+    float                      lodNear2_ = 0.0f;
+    float                      lodMid2_ = 0.0f;
+    float                      lodFarMove2_ = 0.0f;
+    std::uint32_t              frame_ = 0;
+    std::vector<PairState>     pairState_;  // pair id -> 상태
+    std::vector<std::uint32_t> pending_;    // pending 인 pair id (중복 가능, 처리 시 flag 로 거름)
+    std::uint64_t              deferredMoves_ = 0;
+
+    // 위치 양자화 / 변경 없는 Move 생략
+    float                      quantStep_ = 0.0f;
+    float                      invQuantStep_ = 0.0f;
+    std::uint64_t              suppressedMoves_ = 0;
+
+    // dead reckoning
+    float                      drError2_ = 0.0f;
+    std::uint32_t              drRefresh_ = 20;
+    float                      frameSec_ = 0.05f;
+
+    // 가시 상한
+    AoiVisibilityParams        vis_{};
+    float                      swapMargin2_ = 1.44f;
+    std::vector<std::uint32_t> crowded_;    // crowded 인 watcher (중복 가능, flag 로 거름)
+    std::uint64_t              crowdedOut_ = 0;
+
+    // 송신 예산
+    struct ScheduledMove
+    {
+        std::uint32_t watcher;
+        float         priority;
+        std::uint32_t pairId;
+    };
+    AoiSendBudget              budget_{};
+    std::vector<std::uint32_t> spent_;      // pool 인덱스 -> 이번 틱 차감된 바이트
+    std::vector<ScheduledMove> schedule_;
+    std::uint64_t              budgetDeferred_ = 0;
+
+    std::size_t                ghostPlayers_ = 0;
 
 private:
-    //  ǥ ->  ǥ
+    std::uint32_t find_index(std::uint64_t id) const;
+
+    // 월드 좌표 -> 섹터 좌표 (필드 범위로 클램프)
     AoiSectorCoord world_to_sector(const AoiVec2& pos) const;
+    std::uint32_t  sector_index(const AoiSectorCoord& c) const {
+        return static_cast<std::uint32_t>(c.x + c.y * width_);
+    }
+    AoiSectorRect  view_window(const AoiSectorCoord& center) const;
+    std::uint32_t  window_slot_index(int sx, int sy) const {
+        const int side = viewRadius_ * 2 + 1;
+        return static_cast<std::uint32_t>((sx % side) + (sy % side) * side);
+    }
+
+    // 월드 좌표 AABB 가 걸치는 섹터 사각형 (클램프)
+    AoiSectorRect  sector_rect(float minX, float minY, float maxX, float maxY) const;
+
+    // rect 안 섹터의 (필터에 맞는) 엔티티를 fn(const Entity&) 로 순회
+    template <typename Fn>
+    void for_each_in_rect(const AoiSectorRect& rect, AoiQueryFilter filter, Fn&& fn) const;
 
-    //  
-    Sector* get_or_create_sector(const AoiSectorCoord& c);
-    const Sector* get_sector(const AoiSectorCoord& c) const;
+    // a 에는 있고 b 에는 없는 섹터만 순회 (창 이동 시 들어오고/빠지는 띠)
+    template <typename Fn>
+    static void for_each_rect_diff(const AoiSectorRect& a, const AoiSectorRect& b, Fn&& fn);
 
-    //  membership 
-    void enter_sector(std::uint64_t id, const AoiSectorCoord& c);
-    void leave_sector(std::uint64_t id, const AoiSectorCoord& c);
+    // 섹터 membership 관리 (스왑-삭제, 슬롯 인덱스 갱신)
+    void enter_sector(std::uint32_t idx);
+    void leave_sector(std::uint32_t idx);
 
-    // ÷̾ AOI( ) 
-    void rebuild_player_subscriptions(Entity& e);
+    void add_watcher(std::uint32_t watcherIdx, int sx, int sy);
+    void remove_watcher(std::uint32_t watcherIdx, int sx, int sy);
+    void unsubscribe_all(std::uint32_t watcherIdx);  // 구독 창 전체 해제
 
-    // viewRadius   ǥ Ʈ
-    void collect_view_sectors(const Entity& e,
-        std::vector<AoiSectorCoord>& out) const;
+    // 플레이어 AOI(구독 섹터) 갱신: 섹터가 바뀐 경우에만 호출
+    //  - 예전 창/새 창의 차이(띠)만 처리
+    void rebuild_player_subscriptions(std::uint32_t idx);
 
-    //  watcher鿡 ̺Ʈ 
-    void broadcast_to_sector_watchers(const AoiSectorCoord& c,
-        const AoiEvent& ev, std::int64_t excludeId = 0);
+    // 거리 기반 가시성 평가
+    //  - subject 쪽: idx 를 보는/볼 수 있는 watcher 기준 (매 이동)
+    //  - watcher 쪽: idx 가 보는/볼 수 있는 대상 기준 (섹터 이동 또는 일정 거리 이동 시)
+    void evaluate_subject(std::uint32_t idx, bool sendMove);
+    void evaluate_watcher(std::uint32_t idx);
+
+    static float dist2(const AoiVec2& a, const AoiVec2& b) {
+        const float dx = a.x - b.x;
+        const float dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+    static AoiEvent make_event(AoiEvent::Type type, const Entity& subject) {
+        AoiEvent ev;
+        ev.type = type;
+        ev.subjectId = subject.id;
+        ev.position = subject.pos;
+        ev.velocity = subject.vel;
+        return ev;
+    }
+
+    // 이벤트 기록 + 가시 쌍 갱신 (모든 이벤트는 여기를 거침)
+    void emit(std::uint32_t watcherIdx, std::uint32_t subjectIdx, const AoiEvent& ev);
+
+    // 쌍 단위 Move: 기준값과 같으면 생략, LOD 주기가 아니면 pending 으로만 표시
+    void emit_move(std::uint32_t pairId, float distance2, const AoiEvent& moveEv);
+    AoiVec2 quantize(const AoiVec2& p) const;
+    // 쌍의 클라 상태(기준값 + 외삽)가 subject 현재 상태와 맞는지 -> 맞으면 Move 불필요
+    bool    client_in_sync(std::uint32_t pairId, const Entity& subject) const;
+    LodTier       lod_tier(float distance2) const;
+
+    // 가시 상한: 점수(작을수록 우선) / 자기 자신 제외 가시 수
+    float         visibility_score(const Entity& watcher, const Entity& subject) const;
+    std::size_t   visible_count(std::uint32_t watcherIdx) const;
+    // 보이는 것 중 최하 쌍 (worstScore 도 갱신). 없으면 kInvalid
+    std::uint32_t find_worst(std::uint32_t watcherIdx);
+    // 후보를 들일 수 있으면 true (꽉 찼으면 최하 쌍을 Leave 시키고 자리 만듦)
+    bool          admit(std::uint32_t watcherIdx, std::uint32_t subjectIdx);
+    void          mark_crowded(std::uint32_t watcherIdx);
+
+    // 송신 예산: pending Move 를 우선순위대로 남은 예산만큼 보냄 (advance_frame)
+    void          schedule_moves();
+    void          charge(std::uint32_t watcherIdx, AoiEvent::Type type);
+    std::uint32_t lod_interval(LodTier tier) const;
 };
-static void collect_watchers(const AoiWorld::Sector* s, std::vector<uint64_t>& out);
+
+template <typename Fn>
+void AoiWorld::for_each_watcher(std::uint64_t subjectId, Fn&& fn) const
+{
+    const std::uint32_t s = find_index(subjectId);
+    if (s == kInvalidIndex)
+        return;
+
+    for (auto pairId : pairs_.watched_by(s))
+        fn(pool_[pairs_.pair(pairId).watcher].id);
+}
+
+template <typename Fn>
+void AoiWorld::for_each_owned(Fn&& fn) const
+{
+    for (const Entity& e : pool_) {
+        if (e.alive && !e.ghost)
+            fn(e);
+    }
+}
+
+template <typename Fn>
+void AoiWorld::for_each_in_rect(const AoiSectorRect& rect, AoiQueryFilter filter, Fn&& fn) const
+{
+    for (int sy = rect.minY; sy <= rect.maxY; ++sy) {
+        for (int sx = rect.minX; sx <= rect.maxX; ++sx) {
+            const Sector& s = sectors_[sector_index({ sx, sy })];
+
+            if (filter == AoiQueryFilter::Players) {
+                for (auto i : s.players)
+                    fn(pool_[i]);
+                continue;
+            }
+
+            for (auto i : s.entities) {
+                const Entity& e = pool_[i];
+                if (e.ghost)
+                    continue;   // 다른 리전 소유라 여기서 타겟/판정 대상 아님
+                if (filter == AoiQueryFilter::NonPlayers && e.isPlayer)
+                    continue;
+                fn(e);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void AoiWorld::for_each_rect_diff(const AoiSectorRect& a, const AoiSectorRect& b, Fn&& fn)
+{
+    if (a.empty()) return;
+
+    for (int sy = a.minY; sy <= a.maxY; ++sy) {
+        if (b.empty() || sy < b.minY || sy > b.maxY) {
+            for (int sx = a.minX; sx <= a.maxX; ++sx)
+                fn(sx, sy);
+            continue;
+        }
+
+        // 겹치는 행: b 의 왼쪽/오른쪽으로 삐져나온 부분만
+        const int leftEnd = (a.maxX < b.minX - 1) ? a.maxX : b.minX - 1;
+        for (int sx = a.minX; sx <= leftEnd; ++sx)
+            fn(sx, sy);
+
+        const int rightBegin = (a.minX > b.maxX + 1) ? a.minX : b.maxX + 1;
+        for (int sx = rightBegin; sx <= a.maxX; ++sx)
+            fn(sx, sy);
+    }
+}
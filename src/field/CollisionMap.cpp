@@ -0,0 +1,261 @@
+// CollisionMap.cpp
+#include "CollisionMap.h"
+
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+
+    namespace {
+
+#pragma pack(push, 1)
+        struct CollisionMapHeader
+        {
+            char          magic[4];
+            std::uint32_t version;
+            std::uint32_t width;
+            std::uint32_t height;
+            float         cellSize;
+            float         originX;
+            float         originY;
+            std::uint32_t reserved;
+        };
+#pragma pack(pop)
+        static_assert(sizeof(CollisionMapHeader) == 32, "cmap header must stay 32 bytes");
+
+        constexpr std::uint32_t kCollisionMapVersion = 1;
+
+        // std::floor 는 SSE4.1 없이 빌드하면 함수 호출이라 셀 좌표용으로 직접 내림
+        inline int floor_to_int(float v)
+        {
+            const int i = static_cast<int>(v);
+            return i - (v < static_cast<float>(i));
+        }
+
+        void set_err(std::string* err, const std::string& msg)
+        {
+            if (err) *err = msg;
+        }
+
+    } // namespace
+
+    CollisionMap::Ptr CollisionMap::open(const std::string& path, std::string* err)
+    {
+        // 경로별로 살아 있는 매핑 공유 (마지막 사용자가 놓으면 해제)
+        static std::mutex s_mtx;
+        static std::unordered_map<std::string, std::weak_ptr<const CollisionMap>> s_cache;
+
+        std::lock_guard<std::mutex> lock(s_mtx);
+
+        auto it = s_cache.find(path);
+        if (it != s_cache.end()) {
+            if (auto live = it->second.lock())
+                return live;
+        }
+
+        std::shared_ptr<CollisionMap> map(new CollisionMap());
+        if (!map->map_file(path, err))
+            return nullptr;
+
+        s_cache[path] = map;
+        return map;
+    }
+
+    CollisionMap::~CollisionMap()
+    {
+        unmap();
+    }
+
+    bool CollisionMap::map_file(const std::string& path, std::string* err)
+    {
+#ifdef _WIN32
+        HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            set_err(err, "cannot open collision map: " + path);
+            return false;
+        }
+        file_ = file;
+
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(CollisionMapHeader))) {
+            set_err(err, "collision map too small: " + path);
+            unmap();
+            return false;
+        }
+
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            set_err(err, "CreateFileMapping failed: " + path);
+            unmap();
+            return false;
+        }
+        mapping_ = mapping;
+
+        view_ = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        viewSize_ = static_cast<std::size_t>(size.QuadPart);
+        if (!view_) {
+            set_err(err, "MapViewOfFile failed: " + path);
+            unmap();
+            return false;
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            set_err(err, "cannot open collision map: " + path);
+            return false;
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CollisionMapHeader))) {
+            ::close(fd);
+            set_err(err, "collision map too small: " + path);
+            return false;
+        }
+
+        void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);    // 매핑은 fd 를 닫아도 유지됨
+        if (p == MAP_FAILED) {
+            set_err(err, "mmap failed: " + path);
+            return false;
+        }
+        view_ = p;
+        viewSize_ = static_cast<std::size_t>(st.st_size);
+#endif
+
+        CollisionMapHeader h;
+        std::memcpy(&h, view_, sizeof(h));
+
+        if (std::memcmp(h.magic, "CMAP", 4) != 0 || h.version != kCollisionMapVersion) {
+            set_err(err, "not a collision map (magic/version): " + path);
+            unmap();
+            return false;
+        }
+        if (h.width == 0 || h.height == 0 || !(h.cellSize > 0.0f)) {
+            set_err(err, "collision map has empty grid: " + path);
+            unmap();
+            return false;
+        }
+
+        const std::uint32_t words = (h.width + 63) / 64;
+        const std::size_t need = sizeof(CollisionMapHeader)
+            + static_cast<std::size_t>(words) * h.height * sizeof(std::uint64_t);
+        if (viewSize_ < need) {
+            set_err(err, "collision map truncated: " + path);
+            unmap();
+            return false;
+        }
+
+        width_ = h.width;
+        height_ = h.height;
+        wordsPerRow_ = words;
+        cellSize_ = h.cellSize;
+        invCellSize_ = 1.0f / h.cellSize;
+        originX_ = h.originX;
+        originY_ = h.originY;
+        // 헤더 32바이트 뒤라 8바이트 정렬 유지
+        rows_ = reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(view_) + sizeof(CollisionMapHeader));
+        return true;
+    }
+
+    void CollisionMap::unmap()
+    {
+#ifdef _WIN32
+        if (view_) ::UnmapViewOfFile(view_);
+        if (mapping_) ::CloseHandle(static_cast<HANDLE>(mapping_));
+        if (file_) ::CloseHandle(static_cast<HANDLE>(file_));
+        mapping_ = nullptr;
+        file_ = nullptr;
+#else
+        if (view_) ::munmap(const_cast<void*>(view_), viewSize_);
+#endif
+        view_ = nullptr;
+        viewSize_ = 0;
+        rows_ = nullptr;
+    }
+
+    int CollisionMap::cell_x(float x) const
+    {
+        return floor_to_int((x - originX_) * invCellSize_);
+    }
+
+    int CollisionMap::cell_y(float y) const
+    {
+        return floor_to_int((y - originY_) * invCellSize_);
+    }
+
+    bool CollisionMap::blocked(float x, float y) const
+    {
+        return blocked_cell(cell_x(x), cell_y(y));
+    }
+
+    bool CollisionMap::segment_clear(float fromX, float fromY, float toX, float toY) const
+    {
+        // 셀 단위 좌표로
+        const float gx0 = (fromX - originX_) * invCellSize_;
+        const float gy0 = (fromY - originY_) * invCellSize_;
+        const float gx1 = (toX - originX_) * invCellSize_;
+        const float gy1 = (toY - originY_) * invCellSize_;
+
+        int cx = floor_to_int(gx0);
+        int cy = floor_to_int(gy0);
+        const int ex = floor_to_int(gx1);
+        const int ey = floor_to_int(gy1);
+
+        if (blocked_cell(cx, cy))
+            return false;
+        if (cx == ex && cy == ey)
+            return true;    // 한 틱 이동은 대부분 같은 셀 안
+
+        const float dx = gx1 - gx0;
+        const float dy = gy1 - gy0;
+        const int stepX = (dx > 0.0f) ? 1 : -1;
+        const int stepY = (dy > 0.0f) ? 1 : -1;
+
+        // 다음 세로/가로 경계까지의 t (0..1), 셀 하나 건너는 데 드는 t
+        constexpr float kInf = 1e30f;
+        const float tDeltaX = (dx != 0.0f) ? std::fabs(1.0f / dx) : kInf;
+        const float tDeltaY = (dy != 0.0f) ? std::fabs(1.0f / dy) : kInf;
+        float tMaxX = (dx != 0.0f) ? ((stepX > 0 ? (cx + 1 - gx0) : (gx0 - cx)) * tDeltaX) : kInf;
+        float tMaxY = (dy != 0.0f) ? ((stepY > 0 ? (cy + 1 - gy0) : (gy0 - cy)) * tDeltaY) : kInf;
+
+        // 셀 수 상한 (부동소수 오차로 끝 셀을 지나치지 않도록)
+        int remain = std::abs(ex - cx) + std::abs(ey - cy);
+        while (remain-- > 0) {
+            if (tMaxX < tMaxY) {
+                cx += stepX;
+                tMaxX += tDeltaX;
+            }
+            else if (tMaxY < tMaxX) {
+                cy += stepY;
+                tMaxY += tDeltaY;
+            }
+            else {
+                // 꼭짓점을 정확히 지남: 모서리 양옆 셀 중 하나라도 막혔으면 못 지나감 (벽 틈 새기 방지)
+                if (blocked_cell(cx + stepX, cy) || blocked_cell(cx, cy + stepY))
+                    return false;
+                cx += stepX;
+                cy += stepY;
+                tMaxX += tDeltaX;
+                tMaxY += tDeltaY;
+                --remain;
+            }
+
+            if (blocked_cell(cx, cy))
+                return false;
+        }
+        return true;
+    }
+
+} // namespace core
@@ -0,0 +1,81 @@
+// CollisionMap.h
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace core {
+
+    // =======================
+    // 필드 충돌(이동 가능) 비트맵
+    //  - 파일을 읽기 전용으로 메모리 매핑 -> 같은 맵을 쓰는 필드/채널/리전이 전부 한 사본 공유
+    //  - 셀 = cell_size 정사각형, 비트 1 = 막힘. 맵 밖도 막힘
+    //  - 세그먼트 검사는 지나가는 셀만 따라가는 격자 순회 (Amanatides-Woo DDA)
+    //
+    // 파일 형식 (.cmap, 리틀 엔디언)
+    //  [헤더 32바이트] magic "CMAP", version(u32)=1, width(u32), height(u32),
+    //                  cell_size(f32), origin_x(f32), origin_y(f32), reserved(u32)
+    //  [본문] height 줄, 줄마다 ceil(width/64) 개 u64 (x 비트 = word[x/64] 의 x%64 번째 비트)
+    // =======================
+    class CollisionMap
+    {
+    public:
+        using Ptr = std::shared_ptr<const CollisionMap>;
+
+        // 같은 경로는 살아 있는 매핑을 재사용. 파일이 없거나 형식이 틀리면 nullptr (err 에 사유)
+        static Ptr open(const std::string& path, std::string* err = nullptr);
+
+        ~CollisionMap();
+        CollisionMap(const CollisionMap&) = delete;
+        CollisionMap& operator=(const CollisionMap&) = delete;
+
+        std::uint32_t width() const { return width_; }
+        std::uint32_t height() const { return height_; }
+        float         cell_size() const { return cellSize_; }
+
+        // 셀 좌표 기준 (범위 밖 = 막힘)
+        bool blocked_cell(int cx, int cy) const
+        {
+            if (cx < 0 || cy < 0 || cx >= static_cast<int>(width_) || cy >= static_cast<int>(height_))
+                return true;
+            const std::uint64_t w = rows_[static_cast<std::size_t>(cy) * wordsPerRow_ + (cx >> 6)];
+            return (w >> (cx & 63)) & 1u;
+        }
+
+        // 월드 좌표 <-> 셀 좌표
+        int   cell_x(float x) const;
+        int   cell_y(float y) const;
+        float cell_center_x(int cx) const { return originX_ + (static_cast<float>(cx) + 0.5f) * cellSize_; }
+        float cell_center_y(int cy) const { return originY_ + (static_cast<float>(cy) + 0.5f) * cellSize_; }
+
+        // 월드 좌표 기준
+        bool blocked(float x, float y) const;
+        // from -> to 직선이 막힌 셀을 하나도 안 지나면 true (양 끝 셀 포함)
+        bool segment_clear(float fromX, float fromY, float toX, float toY) const;
+
+    private:
+        CollisionMap() = default;
+        bool map_file(const std::string& path, std::string* err);
+        void unmap();
+
+        std::uint32_t        width_ = 0;
+        std::uint32_t        height_ = 0;
+        std::uint32_t        wordsPerRow_ = 0;
+        float                cellSize_ = 1.0f;
+        float                invCellSize_ = 1.0f;
+        float                originX_ = 0.0f;
+        float                originY_ = 0.0f;
+        const std::uint64_t* rows_ = nullptr;   // 매핑 안 본문 시작
+
+        // 매핑 핸들
+        const void*          view_ = nullptr;
+        std::size_t          viewSize_ = 0;
+#ifdef _WIN32
+        void*                file_ = nullptr;
+        void*                mapping_ = nullptr;
+#endif
+    };
+
+} // namespace core
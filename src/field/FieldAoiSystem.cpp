@@ -1,94 +1,252 @@
 // FieldAoiSystem.cpp
 #include "FieldAoiSystem.h"
 
+#include <algorithm>
+
 namespace core {
 
     FieldAoiSystem::FieldAoiSystem(int fieldId,
-        float sectorSize,
-        int   viewRadiusSectors)
+        const config::AoiConfig& cfg,
+        float worldWidth,
+        float worldHeight,
+        float tickSec)
         : fieldId_(fieldId)
-        , aoi_(sectorSize, viewRadiusSectors)
-    {        
-        // sendFunc_    
-    }
-
-    void FieldAoiSystem::set_send_func(FieldAoiSendFunc func)
+        , aoi_(cfg.sector_size, cfg.view_radius_sectors, worldWidth, worldHeight)
     {
-        sendFunc_ = std::move(func);
-        setup_aoi_callback();   //   AOI ݹ 
-    }
+        aoi_.set_interest_radius(cfg.enter_radius, cfg.leave_radius);
 
-    void FieldAoiSystem::setup_aoi_callback()
-    {
-        aoi_.set_send_callback(
-            [this](std::uint64_t watcherId, const AoiEvent& ev)
-            {
-                // watchers_ 
-                auto& vec = watchers_[ev.subjectId];
-
-                switch (ev.type)
-                {
-                case AoiEvent::Type::Snapshot:
-                case AoiEvent::Type::Enter:
-                case AoiEvent::Type::Move:
-                {
-                    // subjectId   ִ watcher Ʈ ߰ (ߺ üũ)
-                    auto it = std::find(vec.begin(), vec.end(), watcherId);
-                    if (it == vec.end())
-                        vec.push_back(watcherId);
-                    break;
-                }
-                case AoiEvent::Type::Leave:
-                {
-                    auto it = std::find(vec.begin(), vec.end(), watcherId);
-                    if (it != vec.end())
-                        vec.erase(it);
-                    break;
-                }
-                }
+        AoiLodParams lod;
+        lod.nearRadius = cfg.lod_near_radius;
+        lod.midRadius = cfg.lod_mid_radius;
+        lod.midInterval = cfg.lod_mid_interval_ticks;
+        lod.farMinMove = cfg.lod_far_min_move;
+        lod.farMaxInterval = cfg.lod_far_max_interval_ticks;
+        aoi_.set_lod(lod);
+        aoi_.set_move_quantization(cfg.move_quant_step);
+        aoi_.set_dead_reckoning(cfg.dead_reckoning ? cfg.dr_error_m : 0.0f, cfg.dr_refresh_ticks, tickSec);
 
-                //  ʱȭ ̸ ܺηδ  
-                if (!initialized_ || !sendFunc_)
-                    return;
+        AoiVisibilityParams vis;
+        vis.maxVisible = cfg.max_visible;
+        vis.playerWeight = cfg.visible_player_weight;
+        vis.npcWeight = cfg.visible_npc_weight;
+        vis.swapMargin = cfg.visible_swap_margin;
+        vis.rerankInterval = cfg.visible_rerank_ticks;
+        aoi_.set_visibility_cap(vis);
 
-                //  ϴ FieldCmd/CombatEvent 
-                sendFunc_(watcherId, ev);
-            }
-        );
+        AoiSendBudget budget;
+        budget.bytesPerFrame = static_cast<std::uint32_t>(cfg.send_budget_bytes_per_sec * tickSec);
+        budget.focusBoost = cfg.send_focus_boost;
+        aoi_.set_send_budget(budget);
     }
 
-
     void FieldAoiSystem::tick_update()
     {
-        // ʿϸ ü AOI 
+        // 필요하면 전체 AOI 리프레시
     }
 
     void FieldAoiSystem::add_entity(std::uint64_t id, bool isPlayer, float x, float y)
     {
+        std::lock_guard<std::mutex> lock(mtx_);
+
         AoiVec2 pos{ x, y };
         aoi_.add_entity(id, isPlayer, pos);
     }
 
-    void FieldAoiSystem::move_entity(std::uint64_t id, float x, float y)
+    void FieldAoiSystem::move_entity(std::uint64_t id, float x, float y, float vx, float vy)
     {
+        std::lock_guard<std::mutex> lock(mtx_);
+
         AoiVec2 pos{ x, y };
-        aoi_.move_entity(id, pos);
+        aoi_.move_entity(id, pos, AoiVec2{ vx, vy });
     }
 
     void FieldAoiSystem::remove_entity(std::uint64_t id)
     {
+        std::lock_guard<std::mutex> lock(mtx_);
+
         aoi_.remove_entity(id);
-        watchers_.erase(id);
+    }
+
+    void FieldAoiSystem::add_or_move_ghost(std::uint64_t id, bool isMonster, float x, float y, float vx, float vy)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        AoiVec2 pos{ x, y };
+        if (const auto* e = aoi_.get_entity(id)) {
+            if (e->ghost)   // 이 리전 소유 엔티티는 건드리지 않음 (핸드오프 직후 늦게 온 갱신)
+                aoi_.move_entity(id, pos, AoiVec2{ vx, vy });
+        }
+        else {
+            aoi_.add_ghost(id, pos, /*playerKind=*/!isMonster);
+        }
+    }
+
+    void FieldAoiSystem::set_focus(std::uint64_t watcherId, std::uint64_t subjectId)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        aoi_.set_focus(watcherId, subjectId);
+    }
+
+    std::size_t FieldAoiSystem::ghost_players()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return aoi_.ghost_players();
+    }
+
+    void FieldAoiSystem::collect_observed(AoiObservedMask& out)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        aoi_.collect_observed(out);
+    }
+
+    bool FieldAoiSystem::is_ghost(std::uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return aoi_.is_ghost(id);
+    }
+
+    bool FieldAoiSystem::demote_to_ghost(std::uint64_t id, std::vector<std::uint64_t>& visibleOut)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return aoi_.demote_to_ghost(id, visibleOut);
+    }
+
+    void FieldAoiSystem::adopt_player(std::uint64_t id, float x, float y, const std::vector<std::uint64_t>& visible)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        AoiVec2 pos{ x, y };
+        aoi_.adopt_player(id, pos, visible);
+    }
+
+    void FieldAoiSystem::collect_owned(std::vector<AoiOwnedEntity>& out)
+    {
+        out.clear();
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        aoi_.for_each_owned([&](const AoiWorld::Entity& e) {
+            out.push_back(AoiOwnedEntity{ e.id, e.isPlayer, e.pos, e.vel });
+        });
     }
 
     void FieldAoiSystem::for_each_watcher(
         uint64_t subjectId,
         std::function<void(uint64_t watcherId)> fn)
     {
-        auto it = watchers_.find(subjectId);
-        if (it == watchers_.end()) return;
+        // fn 안에서 AOI 를 다시 건드려도 되도록 목록만 복사해서 락 밖에서 호출
+        std::vector<uint64_t> list;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            list.reserve(aoi_.watcher_count(subjectId));
+            aoi_.for_each_watcher(subjectId, [&](std::uint64_t w) { list.push_back(w); });
+        }
 
-        for (uint64_t watcher : it->second)
+        for (uint64_t watcher : list)
             fn(watcher);
     }
+
+    std::uint64_t FieldAoiSystem::find_nearest_player(float x, float y, float radius)
+    {
+        thread_local std::vector<AoiQueryHit> hits;
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (aoi_.query_nearest({ x, y }, radius, 1, AoiQueryFilter::Players, hits) == 0)
+            return 0;
+        return hits.front().id;
+    }
+
+    std::size_t FieldAoiSystem::query_nearest(const AoiVec2& center, float radius, std::size_t k,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return aoi_.query_nearest(center, radius, k, filter, out);
+    }
+
+    std::size_t FieldAoiSystem::query_circle(const AoiVec2& center, float radius,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return aoi_.query_circle(center, radius, filter, out);
+    }
+
+    std::size_t FieldAoiSystem::query_cone(const AoiVec2& origin, const AoiVec2& dir, float radius, float halfAngleRad,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return aoi_.query_cone(origin, dir, radius, halfAngleRad, filter, out);
+    }
+
+    std::size_t FieldAoiSystem::query_segment(const AoiVec2& from, const AoiVec2& to, float halfWidth,
+        AoiQueryFilter filter, std::vector<AoiQueryHit>& out)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return aoi_.query_segment(from, to, halfWidth, filter, out);
+    }
+
+    void FieldAoiSystem::flush_events(const FlushFunc& fn)
+    {
+        // 1) 생산 버퍼를 통째로 가져옴 (락은 swap 동안만)
+        flushBuf_.clear();
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            aoi_.advance_frame();
+            aoi_.events().swap(flushBuf_);
+        }
+
+        const std::size_t n = flushBuf_.size();
+        if (n == 0)
+            return;
+
+        // 아직 초기화 중이면 외부로는 안 보냄
+        if (!initialized_)
+            return;
+
+        // 2) (watcher, 자기 자신 먼저, subject, 발생 순서) 로 정렬
+        //  - 같은 watcher/subject 안에서는 발생 순서가 유지됨
+        //  - 입장 묶음에서 클라가 자기 캐릭터를 다른 엔티티보다 먼저 만들도록 self 를 앞으로
+        order_.resize(n);
+        for (std::uint32_t i = 0; i < n; ++i)
+            order_[i] = i;
+
+        const AoiEventBuffer& evs = flushBuf_;
+        std::sort(order_.begin(), order_.end(),
+            [&evs](std::uint32_t a, std::uint32_t b)
+            {
+                if (evs.watcher[a] != evs.watcher[b]) return evs.watcher[a] < evs.watcher[b];
+                const bool selfA = evs.subject[a] == evs.watcher[a];
+                const bool selfB = evs.subject[b] == evs.watcher[b];
+                if (selfA != selfB) return selfA;
+                if (evs.subject[a] != evs.subject[b]) return evs.subject[a] < evs.subject[b];
+                return a < b;
+            });
+
+        // 3) 중복 제거: 바로 뒤에 같은 subject 의 Move 가 또 있으면 앞의 Move 는 버림
+        kept_.clear();
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::uint32_t i = order_[k];
+            if (evs.type[i] == AoiEvent::Type::Move && k + 1 < n) {
+                const std::uint32_t j = order_[k + 1];
+                if (evs.type[j] == AoiEvent::Type::Move &&
+                    evs.watcher[j] == evs.watcher[i] &&
+                    evs.subject[j] == evs.subject[i]) {
+                    ++droppedMoves_;
+                    continue;
+                }
+            }
+            kept_.push_back(i);
+        }
+
+        // 4) watcher 단위로 한 번씩 넘김
+        std::size_t begin = 0;
+        while (begin < kept_.size()) {
+            const std::uint64_t watcherId = evs.watcher[kept_[begin]];
+            std::size_t end = begin + 1;
+            while (end < kept_.size() && evs.watcher[kept_[end]] == watcherId)
+                ++end;
+
+            fn(watcherId, AoiEventBatch(evs, kept_.data() + begin, end - begin));
+            begin = end;
+        }
+    }
 } // namespace core
@@ -3,42 +3,114 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <cstdint>
 
 #include "worker/worker.h"     // NetMessage, MessageType
 #include "AoiWorld.h"   // AoiWorld, AoiEvent
-#include "generated/field_generated.h"  //  field::FieldCmd, field::FieldCmdType
+#include "config/server_config.h"
+#include "generated/field_generated.h"  // ★ field::FieldCmd, field::FieldCmdType
 
 namespace core {
 
-    using FieldAoiSendFunc = std::function<void(std::uint64_t watcherId,
-        const AoiEvent& ev)>;
+    // 한 watcher 에게 갈 이번 틱 이벤트 묶음 (AoiEventBuffer 위의 인덱스 뷰)
+    class AoiEventBatch
+    {
+    public:
+        AoiEventBatch(const AoiEventBuffer& buf, const std::uint32_t* idx, std::size_t count)
+            : buf_(buf), idx_(idx), count_(count) {}
+
+        std::size_t size() const { return count_; }
+        AoiEvent operator[](std::size_t i) const { return buf_.at(idx_[i]); }
+
+    private:
+        const AoiEventBuffer& buf_;
+        const std::uint32_t*  idx_;
+        std::size_t           count_;
+    };
+
+    // 리전 경계 복제용 소유 엔티티 스냅샷
+    struct AoiOwnedEntity
+    {
+        std::uint64_t id = 0;
+        bool          isPlayer = false;
+        AoiVec2       pos{};
+        AoiVec2       vel{};
+    };
 
     class FieldAoiSystem
     {
 	 public:
-        using SendFunc = std::function<void(std::uint64_t watcherId,const AoiEvent& ev)>;
+        // watcher 한 명당 한 번 호출
+        using FlushFunc = std::function<void(std::uint64_t watcherId, const AoiEventBatch& batch)>;
 
-        FieldAoiSystem(int fieldId,float sectorSize,int   viewRadiusSectors);
+        // tickSec: tick_update/flush 한 번의 시간 (dead reckoning 외삽 기준)
+        FieldAoiSystem(int fieldId, const config::AoiConfig& cfg, float worldWidth, float worldHeight, float tickSec);
         
-        void set_initialized(bool v) { initialized_ = v; }
+        // 초기화 중(스폰 등)에 쌓인 이벤트는 버림
+        void set_initialized(bool v)
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            aoi_.events().clear();
+            initialized_ = v;
+        }
         void tick_update();
 
-        // 2)  ο   AOI API
+        // 2) 서버 내부에서 직접 쓰는 AOI API
         void add_entity(std::uint64_t id, bool isPlayer, float x, float y);
-        void move_entity(std::uint64_t id, float x, float y);
+        //  - (vx, vy): 이동 속도 (m/s). 0 = 정지/순간이동
+        void move_entity(std::uint64_t id, float x, float y, float vx = 0.f, float vy = 0.f);
         void remove_entity(std::uint64_t id);
-        using Callback = std::function<void(std::uint64_t watcherId, const AoiEvent& ev)>;
+
+        // watcher 의 현재 타겟 (가시 상한이 꽉 차도 항상 보임). 0 = 해제
+        void set_focus(std::uint64_t watcherId, std::uint64_t subjectId);
+
+        // 리전 경계 (ghost 복제 / 플레이어 핸드오프)
+        void add_or_move_ghost(std::uint64_t id, bool isMonster, float x, float y, float vx, float vy);
+        bool is_ghost(std::uint64_t id);
+        std::size_t ghost_players();
+
+        // 플레이어 시야 창 안인 섹터 스냅샷 (몬스터 동결 판단용, 몬스터 스텝마다 한 번)
+        void collect_observed(AoiObservedMask& out);
+        bool demote_to_ghost(std::uint64_t id, std::vector<std::uint64_t>& visibleOut);
+        void adopt_player(std::uint64_t id, float x, float y, const std::vector<std::uint64_t>& visible);
+        void collect_owned(std::vector<AoiOwnedEntity>& out);   // out 은 비우고 채움
                 
         void for_each_watcher(uint64_t subjectId, std::function<void(uint64_t watcherId)> fn);
-        void set_send_func(FieldAoiSendFunc func);
+
+        // 공간 질의 (AI 타겟팅/스킬/AoE 용, AoiWorld 그리드 재사용)
+        //  - radius 안 가장 가까운 플레이어 (없으면 0)
+        std::uint64_t find_nearest_player(float x, float y, float radius);
+        std::size_t query_nearest(const AoiVec2& center, float radius, std::size_t k,
+            AoiQueryFilter filter, std::vector<AoiQueryHit>& out);
+        std::size_t query_circle(const AoiVec2& center, float radius,
+            AoiQueryFilter filter, std::vector<AoiQueryHit>& out);
+        std::size_t query_cone(const AoiVec2& origin, const AoiVec2& dir, float radius, float halfAngleRad,
+            AoiQueryFilter filter, std::vector<AoiQueryHit>& out);
+        std::size_t query_segment(const AoiVec2& from, const AoiVec2& to, float halfWidth,
+            AoiQueryFilter filter, std::vector<AoiQueryHit>& out);
+
+        // 틱 끝에서 호출: 쌓인 이벤트를 watcher 별로 정렬/중복 제거 후 fn 으로 넘김
+        //  - 같은 subject 의 연속 Move 는 마지막 것만 남김
+        void flush_events(const FlushFunc& fn);
+
+        std::uint64_t dropped_moves() const { return droppedMoves_; }
+        std::uint64_t deferred_moves() const { return aoi_.deferred_moves(); }
+        std::uint64_t suppressed_moves() const { return aoi_.suppressed_moves(); }
+        std::uint64_t crowded_out() const { return aoi_.crowded_out(); }
+        std::uint64_t budget_deferred() const { return aoi_.budget_deferred(); }
     private:
         int fieldId_;
         AoiWorld      aoi_;
-        FieldAoiSendFunc sendFunc_;
-        Callback callback_;
-        std::unordered_map<uint64_t,std::vector<uint64_t>> watchers_;
-        void setup_aoi_callback();  
+
+        // 메시지 스레드(입력 이동)와 틱 스레드가 같이 만지므로 보호
+        std::mutex mtx_;
+
+        // flush 용 (생산 버퍼와 swap 해서 락 밖에서 처리)
+        AoiEventBuffer             flushBuf_;
+        std::vector<std::uint32_t> order_;
+        std::vector<std::uint32_t> kept_;
+        std::uint64_t              droppedMoves_ = 0;
 
         bool initialized_ = false;
      
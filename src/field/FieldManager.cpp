@@ -1,41 +1,358 @@
 #include "field/FieldManager.h"
 
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
 namespace core {
 
+    int FieldManager::FieldInstance::player_count() const
+    {
+        int n = 0;
+        for (const auto& w : regions) {
+            if (w) n += w->player_count();
+        }
+        return n;
+    }
+
+    int FieldManager::tick_slot(int fieldId, int channel, int regionCount, int region)
+    {
+        // 같은 필드의 채널/리전들은 서로 다른 틱 스레드로 퍼지도록 (필드, 채널, 리전) 을 한 번호로
+        //  - 채널*리전수+리전 은 필드 안에서 겹치지 않고, 필드끼리는 kSlotsPerField 간격
+        constexpr std::uint32_t kSlotsPerField = 1024;
+        const std::uint32_t local = static_cast<std::uint32_t>(channel * regionCount + region);
+        const std::uint32_t key = static_cast<std::uint32_t>(fieldId) * kSlotsPerField + local;
+        return static_cast<int>(key % static_cast<std::uint32_t>(ThreadRoleRegistry::instance().tick_slots()));
+    }
+
+    FieldManager::FieldInstance FieldManager::build_instance(int fieldId, int channel, const config::AoiConfig& aoi,
+        const FieldRegionLayout& layout, const CollisionMap::Ptr& collision,
+        const config::FieldPathConfig& pathCfg)
+    {
+        FieldInstance inst;
+
+        // 필드 메모리(몬스터/AOI)는 그 리전을 돌릴 틱 스레드의 NUMA 노드에 잡히도록
+        // 리전마다 생성 구간만 현재 스레드를 그 틱 슬롯 CPU 에 묶어둠 (first-touch)
+        auto& roles = ThreadRoleRegistry::instance();
+        for (int r = 0; r < layout.region_count(); ++r) {
+            ScopedThreadAffinity bind(roles.tick_slot_cpus(tick_slot(fieldId, channel, layout.region_count(), r)));
+            inst.regions.push_back(std::make_shared<FieldWorker>(fieldId, aoi, layout, r, channel,
+                collision, pathCfg));
+        }
+
+        for (auto& w : inst.regions) {
+            w->start();
+        }
+
+        return inst;
+    }
+
     std::shared_ptr<FieldWorker> FieldManager::create_field(int fieldId)
     {
         std::lock_guard<std::mutex> lock(mutex_);
 
         auto it = fields_.find(fieldId);
         if (it != fields_.end()) {
-            return it->second;
+            return it->second.channels.at(0).regions.front();
+        }
+
+        // 경계 복제 폭은 leave 반경 + 핸드오프 여유보다 작으면 안 됨
+        //  (경계 너머 watcher 가 leave 반경 안의 엔티티를 못 보게 됨)
+        const config::AoiConfig& aoi = cfg_.aoi_for(fieldId);
+        const config::FieldPartitionConfig& part = cfg_.partition_for(fieldId);
+        const float margin = std::max(part.ghost_margin, aoi.leave_radius + FieldWorker::kHandoffSlack);
+
+        FieldEntry& entry = fields_[fieldId];
+        entry.layout = FieldRegionLayout(FieldWorker::kFieldWidth, FieldWorker::kFieldHeight,
+            part.cols, part.rows, margin);
+
+        if (!cfg_.map_dir.empty()) {
+            const std::string path = cfg_.map_dir + "/field_" + std::to_string(fieldId) + ".cmap";
+            std::string err;
+            entry.collision = CollisionMap::open(path, &err);
+            if (entry.collision) {
+                std::cout << "[FieldManager] collision map field=" << fieldId << " " << path
+                    << " (" << entry.collision->width() << "x" << entry.collision->height()
+                    << " cell=" << entry.collision->cell_size() << ")\n";
+            }
+            else {
+                std::cout << "[FieldManager] no collision for field=" << fieldId << ": " << err << "\n";
+            }
         }
 
-        auto worker = std::make_shared<FieldWorker>(fieldId);
-        worker->start();
-        fields_[fieldId] = worker;
-        return worker;
+        // 서버 시작 때 한 번이라 락 안에서 만들어도 됨
+        FieldInstance& inst = entry.channels[0] = build_instance(fieldId, 0, aoi, entry.layout, entry.collision, cfg_.path);
+        return inst.regions.front();
     }
 
     std::shared_ptr<FieldWorker> FieldManager::get_field(int fieldId)
+    {
+        return get_region(fieldId, 0, 0);
+    }
+
+    int FieldManager::pick_channel_locked(int fieldId, FieldEntry& entry, bool& createOut)
+    {
+        createOut = false;
+        const config::FieldChannelConfig& cc = cfg_.channel_for(fieldId);
+
+        // 열린 채널 중 가장 한산한 곳
+        int best = 0;
+        int bestLoad = INT_MAX;
+        for (auto& [ch, inst] : entry.channels) {
+            if (inst.draining) continue;
+            const int load = inst.player_count();
+            if (load < bestLoad) {
+                best = ch;
+                bestLoad = load;
+            }
+        }
+
+        if (cc.soft_cap <= 0 || bestLoad < cc.soft_cap)
+            return best;
+
+        // 전부 찼음: drain 중인 채널이 있으면 새로 만들기보다 다시 염 (가장 많이 남은 쪽)
+        int reopen = -1;
+        int reopenLoad = -1;
+        for (auto& [ch, inst] : entry.channels) {
+            if (!inst.draining) continue;
+            const int load = inst.player_count();
+            if (load < cc.soft_cap && load > reopenLoad) {
+                reopen = ch;
+                reopenLoad = load;
+            }
+        }
+        if (reopen >= 0) {
+            FieldInstance& inst = entry.channels[reopen];
+            inst.draining = false;
+            inst.emptySince = {};
+            std::cout << "[FieldManager] reopen field=" << fieldId << " channel=" << reopen << "\n";
+            return reopen;
+        }
+
+        // 상한이거나 이미 다른 입장자가 채널을 만드는 중이면 가장 한산한 곳에 그냥 넣음
+        if (static_cast<int>(entry.channels.size()) >= cc.max_channels || entry.creatingChannel >= 0)
+            return best;
+
+        // 빈 번호 예약. 실제 생성은 호출한 쪽이 락 밖에서
+        int ch = 1;
+        while (entry.channels.count(ch)) ++ch;
+        entry.creatingChannel = ch;
+        createOut = true;
+
+        std::cout << "[FieldManager] open field=" << fieldId << " channel=" << ch
+            << " (busiest=" << bestLoad << "/" << cc.soft_cap << ")\n";
+        return ch;
+    }
+
+    std::shared_ptr<FieldWorker> FieldManager::enter_field(int fieldId, Player::Ptr player)
+    {
+        int ch = 0;
+        bool create = false;
+        config::AoiConfig aoi;
+        config::FieldPathConfig pathCfg;
+        FieldRegionLayout layout;
+        CollisionMap::Ptr collision;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = fields_.find(fieldId);
+            if (it == fields_.end()) {
+                return nullptr;
+            }
+
+            ch = pick_channel_locked(fieldId, it->second, create);
+            if (!create) {
+                std::shared_ptr<FieldWorker> worker = it->second.channels[ch].regions.front();
+
+                // add_player 는 명령만 넣고 인원을 바로 잡으므로 락 안에서
+                //  (동시에 들어온 입장자들이 같은 채널 인원을 보고 한쪽으로 몰리지 않게)
+                if (worker && player) {
+                    worker->add_player(player);
+                }
+                return worker;
+            }
+
+            aoi = cfg_.aoi_for(fieldId);
+            pathCfg = cfg_.path;
+            layout = it->second.layout;
+            collision = it->second.collision;
+        }
+
+        // 새 채널: 워커 생성(몬스터 스폰, AOI 그리드, 스레드)은 락 밖에서. 그동안 라우팅은 안 막힘
+        FieldInstance inst = build_instance(fieldId, ch, aoi, layout, collision, pathCfg);
+
+        std::shared_ptr<FieldWorker> worker = inst.regions.front();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = fields_.find(fieldId);
+            if (it != fields_.end()) {
+                it->second.channels[ch] = std::move(inst);
+                it->second.creatingChannel = -1;
+
+                if (worker && player) {
+                    worker->add_player(player);
+                }
+                return worker;
+            }
+        }
+
+        // 만드는 사이 stop_all 로 필드가 내려감
+        for (auto& w : inst.regions) {
+            w->stop();
+        }
+        return nullptr;
+    }
+
+    void FieldManager::update_channels()
+    {
+        std::vector<std::shared_ptr<FieldWorker>> reclaimed;
+        const auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            for (auto& [fieldId, entry] : fields_) {
+                const config::FieldChannelConfig& cc = cfg_.channel_for(fieldId);
+                if (cc.soft_cap <= 0 || entry.channels.size() <= 1)
+                    continue;
+
+                // 1) 채널 하나를 빼도 나머지로 충분하면 번호 큰 열린 채널부터 drain
+                int total = 0;
+                int open = 0;
+                int lastOpen = 0;
+                for (auto& [ch, inst] : entry.channels) {
+                    total += inst.player_count();
+                    if (!inst.draining) {
+                        ++open;
+                        lastOpen = ch;
+                    }
+                }
+                if (open > 1 && lastOpen != 0
+                    && total <= static_cast<int>((open - 1) * cc.soft_cap * cc.drain_ratio)) {
+                    entry.channels[lastOpen].draining = true;
+                    std::cout << "[FieldManager] drain field=" << fieldId << " channel=" << lastOpen
+                        << " (total=" << total << ")\n";
+                }
+
+                // 2) drain 중 reclaim_idle_sec 동안 비어 있던 채널 회수 (채널 0 제외)
+                for (auto it = entry.channels.begin(); it != entry.channels.end();) {
+                    FieldInstance& inst = it->second;
+                    if (it->first == 0 || !inst.draining) {
+                        ++it;
+                        continue;
+                    }
+
+                    if (inst.player_count() > 0) {
+                        inst.emptySince = {};
+                        ++it;
+                        continue;
+                    }
+                    if (inst.emptySince == std::chrono::steady_clock::time_point{}) {
+                        inst.emptySince = now;
+                        ++it;
+                        continue;
+                    }
+                    if (now - inst.emptySince < std::chrono::seconds(cc.reclaim_idle_sec)) {
+                        ++it;
+                        continue;
+                    }
+
+                    std::cout << "[FieldManager] reclaim field=" << fieldId << " channel=" << it->first << "\n";
+                    reclaimed.insert(reclaimed.end(), inst.regions.begin(), inst.regions.end());
+                    it = entry.channels.erase(it);
+                }
+            }
+        }
+
+        // 목록에서 빠졌으니 틱은 더 안 돎. 스레드 join 은 락 밖에서
+        for (auto& w : reclaimed) {
+            w->stop();
+        }
+    }
+
+    int FieldManager::channel_count(int fieldId)
     {
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = fields_.find(fieldId);
-        if (it != fields_.end()) {
-            return it->second;
+        return (it != fields_.end()) ? static_cast<int>(it->second.channels.size()) : 0;
+    }
+
+    std::shared_ptr<FieldWorker> FieldManager::get_region(int fieldId, int region)
+    {
+        return get_region(fieldId, 0, region);
+    }
+
+    std::shared_ptr<FieldWorker> FieldManager::get_region(int fieldId, int channel, int region)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = fields_.find(fieldId);
+        if (it == fields_.end()) {
+            return nullptr;
         }
-        return nullptr;
+        auto cit = it->second.channels.find(channel);
+        if (cit == it->second.channels.end()) {
+            return nullptr;
+        }
+        const auto& regions = cit->second.regions;
+        if (region < 0 || region >= static_cast<int>(regions.size())) {
+            return nullptr;
+        }
+        return regions[region];
+    }
+
+    std::shared_ptr<FieldWorker> FieldManager::get_field_at(int fieldId, float x, float y)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = fields_.find(fieldId);
+        if (it == fields_.end()) {
+            return nullptr;
+        }
+        return it->second.channels.at(0).regions[it->second.layout.region_of(x, y)];
+    }
+
+    void FieldManager::set_player_owner(std::uint64_t playerId, const FieldOwner& owner)
+    {
+        std::lock_guard<std::mutex> lock(ownerMutex_);
+        owners_[playerId] = owner;
+    }
+
+    void FieldManager::clear_player_owner(std::uint64_t playerId, const FieldOwner& owner)
+    {
+        std::lock_guard<std::mutex> lock(ownerMutex_);
+        auto it = owners_.find(playerId);
+        // 이미 다른 리전/채널로 넘어갔으면 그쪽 등록은 유지
+        if (it != owners_.end() && it->second.channel == owner.channel && it->second.region == owner.region) {
+            owners_.erase(it);
+        }
+    }
+
+    FieldOwner FieldManager::player_owner(std::uint64_t playerId)
+    {
+        std::lock_guard<std::mutex> lock(ownerMutex_);
+        auto it = owners_.find(playerId);
+        return (it != owners_.end()) ? it->second : FieldOwner{};
+    }
+
+    std::shared_ptr<FieldWorker> FieldManager::get_player_field(int fieldId, std::uint64_t playerId)
+    {
+        const FieldOwner owner = player_owner(playerId);
+        if (auto w = get_region(fieldId, owner.channel, owner.region)) {
+            return w;
+        }
+        return get_region(fieldId, 0, 0);
     }
 
     void FieldManager::stop_all()
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        for (auto& [id, w] : fields_) {
-            if (w) {
-                w->stop();
+        for (auto& [id, f] : fields_) {
+            for (auto& [ch, inst] : f.channels) {
+                for (auto& w : inst.regions) {
+                    if (w) {
+                        w->stop();
+                    }
+                }
             }
         }
         fields_.clear();
     }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -2,12 +2,25 @@
 
 #include <memory>
 #include <unordered_map>
+#include <map>
 #include <mutex>
+#include <chrono>
+#include <vector>
 
-#include "worker/FieldWorker.h"   // FieldWorker  core::Worker Ѵٰ 
+#include "worker/FieldWorker.h"
+#include "config/server_config.h"   // FieldWorker 가 core::Worker 상속한다고 가정
+#include "field/FieldRegion.h"
+#include "field/CollisionMap.h"
 
 namespace core {
 
+    // 플레이어를 지금 소유한 필드 워커 위치 (채널 + 리전)
+    struct FieldOwner
+    {
+        int channel = 0;
+        int region = 0;
+    };
+
     class FieldManager {
     public:
         static FieldManager& instance()
@@ -16,23 +29,70 @@ namespace core {
             return inst;
         }
 
+        // create_field 전에 한 번 (필드별 AOI 반경 등)
+        void configure(const config::FieldConfig& cfg)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cfg_ = cfg;
+        }
+
+        // 채널 0 생성 (분할 설정이 있으면 리전 수만큼 FieldWorker), 반환은 리전 0
         std::shared_ptr<FieldWorker> create_field(int fieldId);
-        std::shared_ptr<FieldWorker> get_field(int fieldId);
+        std::shared_ptr<FieldWorker> get_field(int fieldId);   // 채널 0, 리전 0
         void stop_all();
 
+        // 새 입장자: 가장 한산한 채널을 골라(필요하면 채널 추가) add_player 까지
+        //  - 반환은 고른 채널의 리전 0 (실제 소유 리전은 입장 좌표 기준)
+        std::shared_ptr<FieldWorker> enter_field(int fieldId, Player::Ptr player);
+
+        // 주기적으로 (메인 루프): 남는 채널 drain, 오래 빈 drain 채널 회수
+        void update_channels();
+
+        int channel_count(int fieldId);
+
+        // 리전 단위 조회 (분할 안 된 필드는 리전 0 하나)
+        std::shared_ptr<FieldWorker> get_region(int fieldId, int region);   // 채널 0
+        std::shared_ptr<FieldWorker> get_region(int fieldId, int channel, int region);
+        std::shared_ptr<FieldWorker> get_field_at(int fieldId, float x, float y);
+
+        // 플레이어를 지금 소유한 채널/리전 (입력 라우팅용, 입장/핸드오프 때 갱신)
+        //  - 등록 안 된 플레이어는 채널 0, 리전 0
+        void set_player_owner(std::uint64_t playerId, const FieldOwner& owner);
+        void clear_player_owner(std::uint64_t playerId, const FieldOwner& owner);
+        FieldOwner player_owner(std::uint64_t playerId);
+        std::shared_ptr<FieldWorker> get_player_field(int fieldId, std::uint64_t playerId);
+
+        // 이 워커를 돌릴 틱 슬롯 (0 .. ThreadRoleRegistry::tick_slots()-1)
+        //  - 틱 루프 배정과 생성 시 first-touch CPU 가 같은 규칙을 씀
+        static int tick_slot(int fieldId, int channel, int regionCount, int region);
+
         // -----------------------------------------------------------------
-        //  ʵ Ŀ  fn(fieldWorker) ȣ
-        //  - TickWorkers ʵ庰 update_world(dt) ȣ  
+        // 모든 필드 워커(채널/리전 포함)에 대해 fn(fieldWorker) 호출
+        //  - TickWorkers에서 필드별 update_world(dt) 호출 등에 사용
+        //  - 락은 목록 복사하는 동안만. fn 은 락 밖에서 불리므로 FieldManager 를 다시 불러도 됨
         // -----------------------------------------------------------------
         template <typename Fn>
         void for_each_field(Fn&& fn)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            for (auto& [id, w] : fields_) {
-                if (w) {
-                    fn(w);
+            thread_local std::vector<std::shared_ptr<FieldWorker>> workers;
+            workers.clear();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& [id, f] : fields_) {
+                    for (auto& [ch, inst] : f.channels) {
+                        for (auto& w : inst.regions) {
+                            if (w) {
+                                workers.push_back(w);
+                            }
+                        }
+                    }
                 }
             }
+
+            for (auto& w : workers) {
+                fn(w);
+            }
+            workers.clear();
         }
 
     private:
@@ -43,8 +103,41 @@ namespace core {
         FieldManager& operator=(const FieldManager&) = delete;
 
     private:
+        // 필드 인스턴스(채널) 하나 = 리전 워커 여러 개
+        struct FieldInstance
+        {
+            std::vector<std::shared_ptr<FieldWorker>> regions;
+            bool draining = false;                            // 새 입장 안 받음
+            std::chrono::steady_clock::time_point emptySince{};
+
+            int player_count() const;
+        };
+
+        // 논리 필드 하나 = 채널 여러 개 (채널 0 은 항상 유지)
+        struct FieldEntry
+        {
+            FieldRegionLayout              layout;
+            CollisionMap::Ptr              collision;   // 채널/리전 전부 같은 매핑 공유 (없으면 nullptr)
+            std::map<int, FieldInstance>   channels;
+            int                            creatingChannel = -1;   // 락 밖에서 만드는 중인 채널 번호
+        };
+
+        // 채널 하나 분량 워커 생성 (몬스터 스폰/AOI 그리드까지 무거움 -> mutex_ 밖에서)
+        static FieldInstance build_instance(int fieldId, int channel, const config::AoiConfig& aoi,
+            const FieldRegionLayout& layout, const CollisionMap::Ptr& collision,
+            const config::FieldPathConfig& pathCfg);
+
+        // mutex_ 잡은 상태에서 호출
+        //  - 새 채널이 필요하면 번호만 예약(creatingChannel)하고 createOut = true
+        int            pick_channel_locked(int fieldId, FieldEntry& entry, bool& createOut);
+
         std::mutex mutex_;
-        std::unordered_map<int, std::shared_ptr<FieldWorker>> fields_;
+        std::unordered_map<int, FieldEntry> fields_;
+        config::FieldConfig cfg_;
+
+        // I/O 스레드가 패킷마다 조회하므로 필드 목록과 락을 따로 둠
+        std::mutex ownerMutex_;
+        std::unordered_map<std::uint64_t, FieldOwner> owners_;   // playerId -> 채널/리전
     };
 
 } // namespace core
\ No newline at end of file
@@ -0,0 +1,73 @@
+// FieldRegion.cpp
+#include "FieldRegion.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+
+    float RegionRect::outside_dist(float x, float y) const
+    {
+        const float dx = std::max({ minX - x, 0.0f, x - maxX });
+        const float dy = std::max({ minY - y, 0.0f, y - maxY });
+        return std::max(dx, dy);
+    }
+
+    FieldRegionLayout::FieldRegionLayout(float worldWidth, float worldHeight, int cols, int rows, float ghostMargin)
+        : width_(worldWidth)
+        , height_(worldHeight)
+        , cols_(std::max(1, cols))
+        , rows_(std::max(1, rows))
+        , margin_(std::max(0.0f, ghostMargin))
+    {
+        cellW_ = width_ / static_cast<float>(cols_);
+        cellH_ = height_ / static_cast<float>(rows_);
+    }
+
+    int FieldRegionLayout::region_of(float x, float y) const
+    {
+        if (!partitioned())
+            return 0;
+
+        const int cx = std::clamp(static_cast<int>(std::floor(x / cellW_)), 0, cols_ - 1);
+        const int cy = std::clamp(static_cast<int>(std::floor(y / cellH_)), 0, rows_ - 1);
+        return cx + cy * cols_;
+    }
+
+    RegionRect FieldRegionLayout::bounds(int region) const
+    {
+        const int cx = region % cols_;
+        const int cy = region / cols_;
+
+        RegionRect r;
+        r.minX = cx * cellW_;
+        r.minY = cy * cellH_;
+        r.maxX = (cx + 1) * cellW_;
+        r.maxY = (cy + 1) * cellH_;
+        return r;
+    }
+
+    void FieldRegionLayout::mirror_targets(int owner, float x, float y, std::vector<int>& out) const
+    {
+        out.clear();
+        if (!partitioned())
+            return;
+
+        // margin 이 리전 한 칸보다 작다고 보고 주변 3x3 리전만 확인
+        const int ox = owner % cols_;
+        const int oy = owner / cols_;
+        const int hx = std::clamp(static_cast<int>(std::floor(x / cellW_)), 0, cols_ - 1);
+        const int hy = std::clamp(static_cast<int>(std::floor(y / cellH_)), 0, rows_ - 1);
+
+        for (int cy = std::max(0, hy - 1); cy <= std::min(rows_ - 1, hy + 1); ++cy) {
+            for (int cx = std::max(0, hx - 1); cx <= std::min(cols_ - 1, hx + 1); ++cx) {
+                const int r = cx + cy * cols_;
+                if (cx == ox && cy == oy)
+                    continue;
+                if (bounds(r).contains(x, y, margin_))
+                    out.push_back(r);
+            }
+        }
+    }
+
+} // namespace core
@@ -0,0 +1,63 @@
+// FieldRegion.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    // 월드 좌표 사각형 [min, max)
+    struct RegionRect
+    {
+        float minX = 0.0f;
+        float minY = 0.0f;
+        float maxX = 0.0f;
+        float maxY = 0.0f;
+
+        bool contains(float x, float y) const {
+            return x >= minX && x < maxX && y >= minY && y < maxY;
+        }
+        // 사방으로 margin 만큼 넓힌 사각형 안인지
+        bool contains(float x, float y, float margin) const {
+            return x >= minX - margin && x < maxX + margin
+                && y >= minY - margin && y < maxY + margin;
+        }
+        // 사각형 밖으로 얼마나 나갔는지 (안이면 0)
+        float outside_dist(float x, float y) const;
+    };
+
+    // =======================
+    // 한 논리 필드를 cols x rows 리전으로 나눈 배치
+    //  - 리전 하나 = FieldWorker 하나 (리전 0 이 기존 필드 워커 자리)
+    //  - 경계에서 margin 안에 있는 엔티티는 인접 리전에 ghost 로 복제됨
+    //    (margin >= leave 반경 이어야 경계 너머 watcher 가 끊김 없이 봄)
+    //  - 1x1 이면 분할 없음 (기존 동작 그대로)
+    // =======================
+    class FieldRegionLayout
+    {
+    public:
+        FieldRegionLayout() = default;
+        FieldRegionLayout(float worldWidth, float worldHeight, int cols, int rows, float ghostMargin);
+
+        int   region_count() const { return cols_ * rows_; }
+        bool  partitioned() const { return region_count() > 1; }
+        float ghost_margin() const { return margin_; }
+
+        // 좌표가 속한 리전 (필드 밖은 가장자리 리전으로 클램프)
+        int        region_of(float x, float y) const;
+        RegionRect bounds(int region) const;
+
+        // owner 외에 (x, y) 를 ghost 로 가져야 하는 리전들 (out 은 비우고 채움)
+        void mirror_targets(int owner, float x, float y, std::vector<int>& out) const;
+
+    private:
+        float width_ = 0.0f;
+        float height_ = 0.0f;
+        int   cols_ = 1;
+        int   rows_ = 1;
+        float cellW_ = 0.0f;
+        float cellH_ = 0.0f;
+        float margin_ = 0.0f;
+    };
+
+} // namespace core
@@ -0,0 +1,253 @@
+// FlowField.cpp
+#include "FlowField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "field/PathService.h"
+
+namespace core {
+
+    namespace {
+
+        // 방향 인덱스 -> 셀 오프셋 (앞 4개 직선, 뒤 4개 대각선)
+        constexpr int kDirs[8][2] = {
+            { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 },
+        };
+        constexpr float kDirCost[8] = {
+            1.0f, 1.0f, 1.0f, 1.0f,
+            1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f,
+        };
+
+        // 목표를 이만큼 아무도 안 쫓으면 흐름장 버림 (필드 틱 기준, 50ms * 40 = 2초)
+        constexpr std::uint32_t kIdleTicks = 40;
+
+    } // namespace
+
+    FlowField::Ptr FlowField::build(CollisionMap::Ptr map, float targetX, float targetY, int radiusCells)
+    {
+        if (!map || radiusCells <= 0)
+            return nullptr;
+
+        const int tx = map->cell_x(targetX);
+        const int ty = map->cell_y(targetY);
+        if (map->blocked_cell(tx, ty))
+            return nullptr;
+
+        std::shared_ptr<FlowField> f(new FlowField());
+        f->map_ = map;
+        f->targetX_ = targetX;
+        f->targetY_ = targetY;
+        f->originX_ = tx - radiusCells;
+        f->originY_ = ty - radiusCells;
+        f->size_ = radiusCells * 2 + 1;
+
+        const int n = f->size_;
+        const int ox = f->originX_;
+        const int oy = f->originY_;
+
+        // 창 안 셀의 막힘 여부를 먼저 펼쳐둠 (Dijkstra/방향 계산에서 반복 조회)
+        std::vector<std::uint8_t> open(static_cast<std::size_t>(n) * n);
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) {
+                open[x + y * n] = map->blocked_cell(ox + x, oy + y) ? 0 : 1;
+            }
+        }
+        auto walk = [&](int x, int y) {
+            return x >= 0 && y >= 0 && x < n && y < n && open[x + y * n];
+        };
+        // (x, y) 에서 d 방향으로 한 칸 갈 수 있는지 (대각선은 양옆이 다 열려 있어야)
+        auto can_step = [&](int x, int y, int d) {
+            const int nx = x + kDirs[d][0];
+            const int ny = y + kDirs[d][1];
+            if (!walk(nx, ny)) return false;
+            if (d >= 4 && (!walk(nx, y) || !walk(x, ny))) return false;
+            return true;
+        };
+
+        // 1) 목표 셀에서 Dijkstra (대칭 이동 규칙이라 "목표까지 비용" 과 같음)
+        constexpr float kInf = std::numeric_limits<float>::max();
+        std::vector<float> cost(static_cast<std::size_t>(n) * n, kInf);
+        std::vector<std::pair<float, int>> heap;
+
+        const int start = radiusCells + radiusCells * n;
+        cost[start] = 0.0f;
+        heap.emplace_back(0.0f, start);
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+            const auto [c, i] = heap.back();
+            heap.pop_back();
+            if (c > cost[i]) continue;
+
+            const int x = i % n;
+            const int y = i / n;
+            for (int d = 0; d < 8; ++d) {
+                if (!can_step(x, y, d)) continue;
+                const int j = (x + kDirs[d][0]) + (y + kDirs[d][1]) * n;
+                const float nc = c + kDirCost[d];
+                if (nc < cost[j]) {
+                    cost[j] = nc;
+                    heap.emplace_back(nc, j);
+                    std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                }
+            }
+        }
+
+        // 2) 셀마다 비용이 가장 많이 줄어드는 이웃
+        f->dir_.assign(static_cast<std::size_t>(n) * n, kNoDir);
+        f->dir_[start] = kAtTarget;
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) {
+                const int i = x + y * n;
+                if (i == start || cost[i] == kInf) continue;
+
+                float best = cost[i];
+                std::int8_t bestDir = kNoDir;
+                for (int d = 0; d < 8; ++d) {
+                    if (!can_step(x, y, d)) continue;
+                    const float c = cost[(x + kDirs[d][0]) + (y + kDirs[d][1]) * n];
+                    if (c < best) {
+                        best = c;
+                        bestDir = static_cast<std::int8_t>(d);
+                    }
+                }
+                f->dir_[i] = bestDir;
+            }
+        }
+        return f;
+    }
+
+    bool FlowField::sample(float x, float y, float& wpX, float& wpY) const
+    {
+        const int cx = map_->cell_x(x) - originX_;
+        const int cy = map_->cell_y(y) - originY_;
+        if (cx < 0 || cy < 0 || cx >= size_ || cy >= size_)
+            return false;
+
+        const std::int8_t d = dir_[cx + cy * size_];
+        if (d == kNoDir)
+            return false;
+        if (d == kAtTarget) {
+            wpX = targetX_;
+            wpY = targetY_;
+            return true;
+        }
+
+        wpX = map_->cell_center_x(originX_ + cx + kDirs[d][0]);
+        wpY = map_->cell_center_y(originY_ + cy + kDirs[d][1]);
+        return true;
+    }
+
+    // --------------------------------------------------------------------
+    // FieldFlowFields
+    // --------------------------------------------------------------------
+    FieldFlowFields::FieldFlowFields(CollisionMap::Ptr map, const config::FieldPathConfig& cfg)
+        : map_(std::move(map))
+        , cfg_(cfg)
+    {
+        radiusCells_ = std::max(1, static_cast<int>(std::ceil(cfg_.flow_radius / map_->cell_size())));
+    }
+
+    void FieldFlowFields::deliver(Built&& b)
+    {
+        std::lock_guard<std::mutex> lock(doneMtx_);
+        done_.push_back(std::move(b));
+    }
+
+    void FieldFlowFields::note_chaser(std::uint64_t targetId, float targetX, float targetY)
+    {
+        Entry& e = entries_[targetId];
+        ++e.chasers;
+        e.lastNoteTick = tick_;
+        e.targetX = targetX;
+        e.targetY = targetY;
+    }
+
+    bool FieldFlowFields::sample(std::uint64_t targetId, float x, float y, float& wpX, float& wpY) const
+    {
+        auto it = entries_.find(targetId);
+        if (it == entries_.end() || !it->second.field)
+            return false;
+
+        // 목표가 순간이동 등으로 크게 벗어났으면 다시 만들 때까지 쓰지 않음
+        const Entry& e = it->second;
+        const float dx = e.field->target_x() - e.targetX;
+        const float dy = e.field->target_y() - e.targetY;
+        const float stale = cfg_.repath_dist * 2.0f;
+        if (dx * dx + dy * dy > stale * stale)
+            return false;
+
+        return e.field->sample(x, y, wpX, wpY);
+    }
+
+    void FieldFlowFields::begin_tick()
+    {
+        ++tick_;
+
+        {
+            std::lock_guard<std::mutex> lock(doneMtx_);
+            doneSwap_.swap(done_);
+        }
+        for (auto& b : doneSwap_) {
+            auto it = entries_.find(b.targetId);
+            if (it == entries_.end())
+                continue;       // 그 사이 버려짐
+            it->second.building = false;
+            it->second.field = std::move(b.field);
+        }
+        doneSwap_.clear();
+
+        const bool async = PathService::instance().running();
+        int submitted = 0;
+
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            Entry& e = it->second;
+            if (tick_ - e.lastNoteTick > kIdleTicks) {
+                it = entries_.erase(it);
+                continue;
+            }
+
+            // 몬스터 스텝이 없던 틱이면 판단 보류
+            const int heat = e.chasers;
+            if (heat == 0) {
+                ++it;
+                continue;
+            }
+            e.chasers = 0;
+
+            if (heat < cfg_.flow_min_chasers || e.building || !async
+                || submitted >= cfg_.flow_builds_per_tick) {
+                ++it;
+                continue;
+            }
+
+            bool need = !e.field;
+            if (!need) {
+                const float dx = e.field->target_x() - e.targetX;
+                const float dy = e.field->target_y() - e.targetY;
+                need = dx * dx + dy * dy > cfg_.repath_dist * cfg_.repath_dist;
+            }
+            if (need) {
+                e.building = true;
+                ++submitted;
+                ++builds_;
+
+                std::weak_ptr<FieldFlowFields> weak = weak_from_this();
+                PathService::instance().submit(
+                    [weak, map = map_, targetId = it->first, x = e.targetX, y = e.targetY, r = radiusCells_]()
+                    {
+                        FlowField::Ptr field = FlowField::build(map, x, y, r);
+                        if (auto self = weak.lock()) {
+                            self->deliver(Built{ targetId, std::move(field) });
+                        }
+                    });
+            }
+            ++it;
+        }
+    }
+
+} // namespace core
@@ -0,0 +1,107 @@
+// FlowField.h
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "field/CollisionMap.h"
+#include "config/server_config.h"
+
+namespace core {
+
+    // =======================
+    // 한 목표(플레이어) 주변 창(window) 위의 흐름장
+    //  - 목표 셀에서 시작한 Dijkstra 비용장 -> 셀마다 비용이 가장 낮은 이웃 방향을 미리 구해둠
+    //  - 같은 목표를 쫓는 몬스터는 각자 경로를 안 구하고 자기 셀 방향만 읽음 (O(1))
+    //  - 이동 규칙은 JPS 와 같음 (8방향, 벽 모서리 대각선 통과 없음)
+    // =======================
+    class FlowField
+    {
+    public:
+        using Ptr = std::shared_ptr<const FlowField>;
+
+        // (targetX, targetY) 중심 반경 radiusCells 셀 창. 목표 셀이 막혔으면 nullptr
+        static Ptr build(CollisionMap::Ptr map, float targetX, float targetY, int radiusCells);
+
+        // (x, y) 가 창 안의 도달 가능 셀이면 다음 셀 중심을 wp 로 (목표 셀이면 목표 좌표)
+        bool sample(float x, float y, float& wpX, float& wpY) const;
+
+        float target_x() const { return targetX_; }
+        float target_y() const { return targetY_; }
+
+    private:
+        FlowField() = default;
+
+        static constexpr std::int8_t kNoDir = -1;
+        static constexpr std::int8_t kAtTarget = 8;
+
+        CollisionMap::Ptr         map_;
+        float                     targetX_ = 0.0f;
+        float                     targetY_ = 0.0f;
+        int                       originX_ = 0;    // 창 왼쪽 아래 셀 (맵 셀 좌표)
+        int                       originY_ = 0;
+        int                       size_ = 0;       // 창 한 변 셀 수
+        std::vector<std::int8_t>  dir_;            // 셀별 이웃 방향 (0..7), kNoDir = 못 감
+    };
+
+    // =======================
+    // FieldWorker 하나의 흐름장 관리 (틱 스레드 전용, 만들기는 PathService 스레드)
+    //  - 직선이 막힌 추적자가 note_chaser 로 목표를 알려줌
+    //  - 한 틱에 추적자가 flow_min_chasers 이상 몰린 목표만 흐름장을 만듦
+    //  - 목표가 repath_dist 넘게 움직이면 다시 만듦 (틱당 flow_builds_per_tick 개까지, 그동안은 이전 것 사용)
+    //  - 한동안 아무도 안 쫓으면 버림
+    // =======================
+    class FieldFlowFields : public std::enable_shared_from_this<FieldFlowFields>
+    {
+    public:
+        using Ptr = std::shared_ptr<FieldFlowFields>;
+
+        FieldFlowFields(CollisionMap::Ptr map, const config::FieldPathConfig& cfg);
+
+        // 틱 시작: 다 만든 흐름장 받기 + 지난 틱 추적자 수 보고 새로 만들 목표 고르기
+        void begin_tick();
+
+        void note_chaser(std::uint64_t targetId, float targetX, float targetY);
+        // 흐름장이 있고 (x, y) 가 창 안이면 다음 웨이포인트
+        bool sample(std::uint64_t targetId, float x, float y, float& wpX, float& wpY) const;
+
+        std::uint64_t builds() const { return builds_; }
+        std::size_t   active() const { return entries_.size(); }
+
+    private:
+        struct Entry
+        {
+            FlowField::Ptr field;
+            float          targetX = 0.0f;
+            float          targetY = 0.0f;
+            int            chasers = 0;         // 이번 라운드(몬스터 스텝)에 알려온 수
+            std::uint32_t  lastNoteTick = 0;
+            bool           building = false;
+        };
+
+        struct Built
+        {
+            std::uint64_t  targetId = 0;
+            FlowField::Ptr field;
+        };
+
+        void deliver(Built&& b);    // PathService 스레드
+
+        CollisionMap::Ptr       map_;
+        config::FieldPathConfig cfg_;
+        int                     radiusCells_ = 0;
+
+        std::unordered_map<std::uint64_t, Entry> entries_;
+        std::uint32_t                            tick_ = 0;
+
+        std::mutex         doneMtx_;
+        std::vector<Built> done_;
+        std::vector<Built> doneSwap_;
+
+        std::uint64_t builds_ = 0;
+    };
+
+} // namespace core
@@ -0,0 +1,57 @@
+// NameTable.cpp
+#include "NameTable.h"
+
+#include <iostream>
+
+namespace core {
+
+    NameTable& NameTable::instance()
+    {
+        static NameTable g;
+        return g;
+    }
+
+    NameTable::NameTable()
+    {
+        // 0 번 = 빈 이름
+        storage_.emplace_back();
+        byId_[kNoName].store(&storage_.back(), std::memory_order_release);
+        count_.store(1, std::memory_order_release);
+    }
+
+    NameId NameTable::intern(std::string_view name)
+    {
+        if (name.empty())
+            return kNoName;
+
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        auto it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second;
+
+        const std::size_t id = count_.load(std::memory_order_relaxed);
+        if (id >= kMaxNames) {
+            std::cout << "[NameTable] full, dropping name: " << name << "\n";
+            return kNoName;
+        }
+
+        storage_.emplace_back(name);
+        const std::string& stored = storage_.back();
+        ids_.emplace(std::string_view(stored), static_cast<NameId>(id));
+
+        byId_[id].store(&stored, std::memory_order_release);
+        count_.store(id + 1, std::memory_order_release);
+        return static_cast<NameId>(id);
+    }
+
+    const std::string& NameTable::name(NameId id) const
+    {
+        if (id < kMaxNames) {
+            if (const std::string* s = byId_[id].load(std::memory_order_acquire))
+                return *s;
+        }
+        return *byId_[kNoName].load(std::memory_order_acquire);
+    }
+
+} // namespace core
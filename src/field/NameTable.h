@@ -0,0 +1,47 @@
+// NameTable.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace core {
+
+    using NameId = std::uint32_t;
+    constexpr NameId kNoName = 0;   // "" (모름/없음)
+
+    // =======================
+    // 프리팹/템플릿 이름 인턴 테이블 (프로세스 공용)
+    //  - ECS/ghost 는 NameId(4바이트)만 들고 다님 -> 몬스터마다 힙 문자열, 리전 간 문자열 복사 없음
+    //  - intern 은 처음 보는 이름일 때만 락, name() 은 락 없이 읽음
+    //  - 한 번 등록한 이름은 프로세스 끝까지 유지 (주소 고정)
+    // =======================
+    class NameTable
+    {
+    public:
+        static constexpr std::size_t kMaxNames = 4096;
+
+        static NameTable& instance();
+
+        NameId intern(std::string_view name);
+        const std::string& name(NameId id) const;
+        std::size_t size() const { return count_.load(std::memory_order_acquire); }
+
+    private:
+        NameTable();
+        NameTable(const NameTable&) = delete;
+        NameTable& operator=(const NameTable&) = delete;
+
+        std::mutex                                          mtx_;
+        std::deque<std::string>                             storage_;   // push_back 해도 기존 원소 주소 유지
+        std::unordered_map<std::string_view, NameId>        ids_;       // 키는 storage_ 를 가리킴
+        std::array<std::atomic<const std::string*>, kMaxNames> byId_{};
+        std::atomic<std::size_t>                            count_{ 0 };
+    };
+
+} // namespace core
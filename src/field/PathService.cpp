@@ -0,0 +1,475 @@
+// PathService.cpp
+#include "PathService.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "worker/threadRole.h"
+
+namespace core {
+
+    namespace {
+
+        constexpr float kSqrt2 = 1.41421356f;
+
+        // 탐색 한 번 동안 쓰는 셀별 상태. 스레드마다 하나씩 두고 세대 번호로 초기화 생략
+        struct JpsScratch
+        {
+            std::vector<float>         g;
+            std::vector<std::int32_t>  parent;
+            std::vector<std::uint32_t> stamp;
+            std::vector<std::uint8_t>  closed;
+            std::uint32_t              gen = 0;
+
+            // (f, 셀) 최소 힙
+            std::vector<std::pair<float, std::int32_t>> open;
+
+            void prepare(std::size_t cells)
+            {
+                if (stamp.size() < cells) {
+                    g.resize(cells);
+                    parent.resize(cells);
+                    closed.resize(cells);
+                    stamp.assign(cells, 0);
+                    gen = 0;
+                }
+                if (++gen == 0) {
+                    std::fill(stamp.begin(), stamp.end(), 0);
+                    gen = 1;
+                }
+                open.clear();
+            }
+
+            bool touched(std::int32_t i) const { return stamp[i] == gen; }
+        };
+
+        class JpsGrid
+        {
+        public:
+            JpsGrid(const CollisionMap& map, int goalX, int goalY)
+                : map_(map), goalX_(goalX), goalY_(goalY) {}
+
+            bool walk(int x, int y) const { return !map_.blocked_cell(x, y); }
+
+            // (x, y) 에서 (dx, dy) 방향으로 다음 점프 포인트까지
+            //  - 대각선은 매 칸 가로/세로 점프를 확인, 가로/세로는 강제 이웃이 생기면 멈춤
+            bool jump(int x, int y, int dx, int dy, int& jx, int& jy) const
+            {
+                for (;;) {
+                    if (!walk(x, y))
+                        return false;
+                    if (x == goalX_ && y == goalY_) {
+                        jx = x;
+                        jy = y;
+                        return true;
+                    }
+
+                    if (dx != 0 && dy != 0) {
+                        int tx, ty;
+                        if (jump(x + dx, y, dx, 0, tx, ty) || jump(x, y + dy, 0, dy, tx, ty)) {
+                            jx = x;
+                            jy = y;
+                            return true;
+                        }
+                        // 모서리 양옆이 다 열려 있어야 대각선 진행
+                        if (!walk(x + dx, y) || !walk(x, y + dy))
+                            return false;
+                    }
+                    else if (dx != 0) {
+                        if ((walk(x, y - 1) && !walk(x - dx, y - 1)) ||
+                            (walk(x, y + 1) && !walk(x - dx, y + 1))) {
+                            jx = x;
+                            jy = y;
+                            return true;
+                        }
+                    }
+                    else {
+                        if ((walk(x - 1, y) && !walk(x - 1, y - dy)) ||
+                            (walk(x + 1, y) && !walk(x + 1, y - dy))) {
+                            jx = x;
+                            jy = y;
+                            return true;
+                        }
+                    }
+
+                    x += dx;
+                    y += dy;
+                }
+            }
+
+            // 진행 방향 기준으로 가지치기한 이웃 방향 (parent 없으면 8방향 전부)
+            int neighbors(int x, int y, int px, int py, bool hasParent, int (*out)[2]) const
+            {
+                int n = 0;
+                auto add = [&](int dx, int dy) { out[n][0] = dx; out[n][1] = dy; ++n; };
+
+                if (!hasParent) {
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            if (dx == 0 && dy == 0) continue;
+                            if (!walk(x + dx, y + dy)) continue;
+                            if (dx != 0 && dy != 0 && (!walk(x + dx, y) || !walk(x, y + dy))) continue;
+                            add(dx, dy);
+                        }
+                    }
+                    return n;
+                }
+
+                const int dx = (x > px) - (x < px);
+                const int dy = (y > py) - (y < py);
+
+                if (dx != 0 && dy != 0) {
+                    const bool nextY = walk(x, y + dy);
+                    const bool nextX = walk(x + dx, y);
+                    if (nextY) add(0, dy);
+                    if (nextX) add(dx, 0);
+                    if (nextX && nextY) add(dx, dy);
+                }
+                else if (dx != 0) {
+                    const bool next = walk(x + dx, y);
+                    const bool up = walk(x, y + 1);
+                    const bool down = walk(x, y - 1);
+                    if (next) {
+                        add(dx, 0);
+                        if (up) add(dx, 1);
+                        if (down) add(dx, -1);
+                    }
+                    if (up) add(0, 1);
+                    if (down) add(0, -1);
+                }
+                else {
+                    const bool next = walk(x, y + dy);
+                    const bool right = walk(x + 1, y);
+                    const bool left = walk(x - 1, y);
+                    if (next) {
+                        add(0, dy);
+                        if (right) add(1, dy);
+                        if (left) add(-1, dy);
+                    }
+                    if (right) add(1, 0);
+                    if (left) add(-1, 0);
+                }
+                return n;
+            }
+
+        private:
+            const CollisionMap& map_;
+            int                 goalX_;
+            int                 goalY_;
+        };
+
+        float octile(int ax, int ay, int bx, int by)
+        {
+            const int dx = std::abs(ax - bx);
+            const int dy = std::abs(ay - by);
+            return static_cast<float>(std::max(dx, dy)) + (kSqrt2 - 1.0f) * static_cast<float>(std::min(dx, dy));
+        }
+
+    } // namespace
+
+    bool FindPathJps(const CollisionMap& map, const PathPoint& from, const PathPoint& to,
+        int maxExpansions, PathPoints& out)
+    {
+        out.clear();
+
+        const int w = static_cast<int>(map.width());
+        const int sx = map.cell_x(from.x);
+        const int sy = map.cell_y(from.y);
+        const int gx = map.cell_x(to.x);
+        const int gy = map.cell_y(to.y);
+
+        if (map.blocked_cell(sx, sy) || map.blocked_cell(gx, gy))
+            return false;
+        if (sx == gx && sy == gy) {
+            out.push_back(to);
+            return true;
+        }
+
+        thread_local JpsScratch s;
+        s.prepare(static_cast<std::size_t>(w) * map.height());
+
+        const JpsGrid grid(map, gx, gy);
+        const std::int32_t start = sx + sy * w;
+        const std::int32_t goal = gx + gy * w;
+
+        auto open_push = [&](float f, std::int32_t i) {
+            s.open.emplace_back(f, i);
+            std::push_heap(s.open.begin(), s.open.end(), std::greater<>());
+        };
+
+        s.stamp[start] = s.gen;
+        s.g[start] = 0.0f;
+        s.parent[start] = -1;
+        s.closed[start] = 0;
+        open_push(octile(sx, sy, gx, gy), start);
+
+        int dirs[8][2];
+        int expansions = 0;
+        bool found = false;
+
+        while (!s.open.empty()) {
+            std::pop_heap(s.open.begin(), s.open.end(), std::greater<>());
+            const std::int32_t cur = s.open.back().second;
+            s.open.pop_back();
+
+            if (s.closed[cur]) continue;    // 더 나쁜 f 로 남아 있던 중복 항목
+            s.closed[cur] = 1;
+
+            if (cur == goal) {
+                found = true;
+                break;
+            }
+            if (++expansions > maxExpansions)
+                break;
+
+            const int cx = cur % w;
+            const int cy = cur / w;
+            const std::int32_t par = s.parent[cur];
+            const int n = grid.neighbors(cx, cy, par >= 0 ? par % w : 0, par >= 0 ? par / w : 0, par >= 0, dirs);
+
+            for (int k = 0; k < n; ++k) {
+                int jx, jy;
+                if (!grid.jump(cx + dirs[k][0], cy + dirs[k][1], dirs[k][0], dirs[k][1], jx, jy))
+                    continue;
+
+                const std::int32_t j = jx + jy * w;
+                if (s.touched(j) && s.closed[j])
+                    continue;
+
+                const float ng = s.g[cur] + octile(cx, cy, jx, jy);
+                if (!s.touched(j) || ng < s.g[j]) {
+                    s.stamp[j] = s.gen;
+                    s.closed[j] = 0;
+                    s.g[j] = ng;
+                    s.parent[j] = cur;
+                    open_push(ng + octile(jx, jy, gx, gy), j);
+                }
+            }
+        }
+
+        if (!found)
+            return false;
+
+        // 목표 -> 출발 역추적 (출발 셀은 빼고, 목표는 정확한 좌표로)
+        out.push_back(to);
+        for (std::int32_t i = s.parent[goal]; i >= 0 && i != start; i = s.parent[i]) {
+            out.push_back(PathPoint{ map.cell_center_x(i % w), map.cell_center_y(i / w) });
+        }
+        std::reverse(out.begin(), out.end());
+        return true;
+    }
+
+    // --------------------------------------------------------------------
+    // PathService
+    // --------------------------------------------------------------------
+    PathService& PathService::instance()
+    {
+        static PathService g;
+        return g;
+    }
+
+    void PathService::start(int threads)
+    {
+        if (threads <= 0 || running())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stopping_ = false;
+        }
+        for (int i = 0; i < threads; ++i) {
+            threads_.emplace_back([this, i] { run(i); });
+        }
+        running_.store(true, std::memory_order_release);
+
+        std::cout << "[PathService] started threads=" << threads << "\n";
+    }
+
+    void PathService::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stopping_ = true;
+            jobs_.clear();      // 남은 요청은 버림 (요청한 필드도 곧 내려감)
+        }
+        running_.store(false, std::memory_order_release);
+        cv_.notify_all();
+
+        for (auto& t : threads_) {
+            if (t.joinable())
+                t.join();
+        }
+        threads_.clear();
+    }
+
+    void PathService::submit(Job job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (stopping_) return;
+            jobs_.push_back(std::move(job));
+        }
+        cv_.notify_one();
+    }
+
+    std::size_t PathService::queued()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return jobs_.size();
+    }
+
+    void PathService::run(int index)
+    {
+        ThreadRoleRegistry::instance().apply_current(ThreadRole::Path, "PathWorker_" + std::to_string(index));
+
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (stopping_)
+                    return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+    // --------------------------------------------------------------------
+    // FieldPathfinder
+    // --------------------------------------------------------------------
+    FieldPathfinder::FieldPathfinder(CollisionMap::Ptr map, const config::FieldPathConfig& cfg)
+        : map_(std::move(map))
+        , cfg_(cfg)
+    {
+    }
+
+    std::uint64_t FieldPathfinder::key_of(const PathPoint& from, const PathPoint& to) const
+    {
+        const std::uint64_t w = map_->width();
+        const std::uint64_t h = map_->height();
+        // 맵 밖 좌표는 가장자리 셀로 (어차피 막힘 판정)
+        auto cell = [&](const PathPoint& p) {
+            const std::uint64_t cx = static_cast<std::uint64_t>(std::clamp<std::int64_t>(map_->cell_x(p.x), 0, static_cast<std::int64_t>(w) - 1));
+            const std::uint64_t cy = static_cast<std::uint64_t>(std::clamp<std::int64_t>(map_->cell_y(p.y), 0, static_cast<std::int64_t>(h) - 1));
+            return cx + cy * w;
+        };
+        return (cell(from) << 32) | cell(to);
+    }
+
+    PathPtr FieldPathfinder::cache_get(std::uint64_t key)
+    {
+        auto it = cache_.find(key);
+        if (it == cache_.end())
+            return nullptr;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+    }
+
+    void FieldPathfinder::cache_put(std::uint64_t key, PathPtr path)
+    {
+        if (cfg_.cache_size <= 0)
+            return;
+
+        auto it = cache_.find(key);
+        if (it != cache_.end()) {
+            it->second->second = std::move(path);
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return;
+        }
+
+        lru_.emplace_front(key, std::move(path));
+        cache_[key] = lru_.begin();
+
+        while (static_cast<int>(lru_.size()) > cfg_.cache_size) {
+            cache_.erase(lru_.back().first);
+            lru_.pop_back();
+        }
+    }
+
+    void FieldPathfinder::deliver(Result&& r)
+    {
+        std::lock_guard<std::mutex> lock(doneMtx_);
+        done_.push_back(std::move(r));
+    }
+
+    void FieldPathfinder::begin_tick()
+    {
+        submittedThisTick_ = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(doneMtx_);
+            doneSwap_.swap(done_);
+        }
+
+        for (auto& r : doneSwap_) {
+            cache_put(r.key, r.path);
+
+            // 그 사이 취소/다른 목표로 다시 요청했으면 캐시에만 남김
+            auto it = pending_.find(r.requester);
+            if (it == pending_.end() || it->second != r.key)
+                continue;
+            pending_.erase(it);
+            ready_[r.requester] = std::move(r);
+        }
+        doneSwap_.clear();
+    }
+
+    bool FieldPathfinder::find(std::uint64_t requester, const PathPoint& from, const PathPoint& to, PathPtr& out)
+    {
+        // 1) 기다리던 결과가 왔으면 (그 사이 목표가 조금 움직였어도) 그대로 씀
+        //    -> 목표가 얼마나 멀어졌는지는 호출자가 repath_dist 로 판단
+        auto rit = ready_.find(requester);
+        if (rit != ready_.end()) {
+            out = std::move(rit->second.path);
+            ready_.erase(rit);
+            return true;
+        }
+
+        // 2) 아직 탐색 중
+        if (pending_.count(requester))
+            return false;
+
+        // 3) 캐시
+        const std::uint64_t key = key_of(from, to);
+        if (PathPtr hit = cache_get(key)) {
+            ++cacheHits_;
+            out = std::move(hit);
+            return true;
+        }
+
+        // 4) 새 요청 (예산 밖이면 다음 틱에)
+        if (!PathService::instance().running())
+            return false;
+        if (submittedThisTick_ >= cfg_.max_requests_per_tick
+            || static_cast<int>(pending_.size()) >= cfg_.max_inflight)
+            return false;
+
+        ++submittedThisTick_;
+        ++searches_;
+        pending_[requester] = key;
+
+        std::weak_ptr<FieldPathfinder> weak = weak_from_this();
+        PathService::instance().submit(
+            [weak, map = map_, requester, key, from, to, maxExp = cfg_.max_expansions]()
+            {
+                auto points = std::make_shared<PathPoints>();
+                FindPathJps(*map, from, to, maxExp, *points);   // 실패면 빈 경로
+
+                if (auto self = weak.lock()) {
+                    self->deliver(Result{ requester, key, std::move(points) });
+                }
+            });
+        return false;
+    }
+
+    void FieldPathfinder::cancel(std::uint64_t requester)
+    {
+        pending_.erase(requester);  // 늦게 온 결과는 begin_tick 에서 캐시에만 들어감
+        ready_.erase(requester);
+    }
+
+} // namespace core
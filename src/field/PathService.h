@@ -0,0 +1,130 @@
+// PathService.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "field/CollisionMap.h"
+#include "config/server_config.h"
+
+namespace core {
+
+    struct PathPoint
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    // 출발점 다음 웨이포인트부터 목표(정확한 좌표)까지. 빈 경로 = 길 없음
+    using PathPoints = std::vector<PathPoint>;
+    using PathPtr = std::shared_ptr<const PathPoints>;
+
+    // 충돌 맵 위 jump point search (8방향, 벽 모서리 대각선 통과 없음)
+    //  - 찾으면 true + out 채움 (셀 중심 점프 포인트들 + 마지막은 to 그대로)
+    //  - 출발/목표 셀이 막혔거나 maxExpansions 안에 못 찾으면 false
+    //  - 스레드별 작업 버퍼를 재사용하므로 같은 스레드에서 재진입 금지
+    bool FindPathJps(const CollisionMap& map, const PathPoint& from, const PathPoint& to,
+        int maxExpansions, PathPoints& out);
+
+    // =======================
+    // 경로 탐색 전용 스레드 풀 (프로세스에 하나)
+    //  - 필드 틱 스레드는 요청만 넣고 바로 돌아감, 결과는 FieldPathfinder 가 다음 틱에 가져감
+    // =======================
+    class PathService
+    {
+    public:
+        using Job = std::function<void()>;
+
+        static PathService& instance();
+
+        void start(int threads);
+        void stop();
+        bool running() const { return running_.load(std::memory_order_acquire); }
+
+        void submit(Job job);
+        std::size_t queued();
+
+    private:
+        PathService() = default;
+        PathService(const PathService&) = delete;
+        PathService& operator=(const PathService&) = delete;
+
+        void run(int index);
+
+        std::mutex               mtx_;
+        std::condition_variable  cv_;
+        std::deque<Job>          jobs_;
+        std::vector<std::thread> threads_;
+        bool                     stopping_ = false;
+        std::atomic<bool>        running_{ false };
+    };
+
+    // =======================
+    // FieldWorker 하나(리전)의 경로 요청 창구
+    //  - find/cancel/begin_tick 은 그 워커의 틱 스레드에서만 호출
+    //  - 틱마다 새 요청 수 / 동시 요청 수 예산이 있고, 넘치면 다음 틱에 다시 물어봄
+    //  - (출발 셀, 목표 셀) 기준 LRU 캐시 (실패한 탐색도 빈 경로로 캐시 -> 같은 요청 폭주 방지)
+    // =======================
+    class FieldPathfinder : public std::enable_shared_from_this<FieldPathfinder>
+    {
+    public:
+        using Ptr = std::shared_ptr<FieldPathfinder>;
+
+        FieldPathfinder(CollisionMap::Ptr map, const config::FieldPathConfig& cfg);
+
+        // 틱 시작: 끝난 탐색 결과를 받아오고 이번 틱 예산 초기화
+        void begin_tick();
+
+        // requester 용 경로
+        //  - 캐시/끝난 결과가 있으면 true (out: 경로, 비었으면 길 없음)
+        //  - 없으면 비동기 요청을 걸고(예산 안에서) false -> 다음 틱에 다시 호출
+        bool find(std::uint64_t requester, const PathPoint& from, const PathPoint& to, PathPtr& out);
+        // 기다리던 요청/결과 버림 (몬스터 제거 등)
+        void cancel(std::uint64_t requester);
+
+        std::uint64_t cache_hits() const { return cacheHits_; }
+        std::uint64_t searches() const { return searches_; }
+
+    private:
+        struct Result
+        {
+            std::uint64_t requester = 0;
+            std::uint64_t key = 0;
+            PathPtr       path;
+        };
+
+        std::uint64_t key_of(const PathPoint& from, const PathPoint& to) const;
+        PathPtr       cache_get(std::uint64_t key);
+        void          cache_put(std::uint64_t key, PathPtr path);
+        void          deliver(Result&& r);     // 탐색 스레드에서 호출
+
+        CollisionMap::Ptr       map_;
+        config::FieldPathConfig cfg_;
+
+        // LRU: 앞쪽이 최근
+        std::list<std::pair<std::uint64_t, PathPtr>> lru_;
+        std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, PathPtr>>::iterator> cache_;
+
+        std::unordered_map<std::uint64_t, std::uint64_t> pending_;   // requester -> 요청 key
+        std::unordered_map<std::uint64_t, Result>        ready_;     // requester -> 이번 틱에 받은 결과
+        int                                              submittedThisTick_ = 0;
+
+        // 탐색 스레드 -> 틱 스레드
+        std::mutex          doneMtx_;
+        std::vector<Result> done_;
+        std::vector<Result> doneSwap_;
+
+        std::uint64_t cacheHits_ = 0;
+        std::uint64_t searches_ = 0;
+    };
+
+} // namespace core
@@ -1,5 +1,6 @@
 #pragma once
 #include "EntityTypes.h"
+#include "field/NameTable.h"
 #include "proto/generated/field_generated.h"
 
 namespace monster_ecs {
@@ -7,6 +8,8 @@ namespace monster_ecs {
     struct CTransform {
         float x = 0.0f;
         float y = 0.0f;
+        float vx = 0.0f;    // AOI 에 마지막으로 알린 속도 (멈출 때 0 을 한 번 알리기 위함)
+        float vy = 0.0f;
     };
 
     struct CStats {
@@ -16,7 +19,7 @@ namespace monster_ecs {
         int sp = 50;        
         int atk = 7;
         int def = 0;
-		bool dirty = false;//   ˸ ʿ 
+		bool dirty = false;// 스탯 변경 알림 필요 여부
     };
 
     struct CMonsterTag {
@@ -26,9 +29,9 @@ namespace monster_ecs {
     struct CSpawnInfo {
         float spawnX = 0.0f;
         float spawnY = 0.0f;
-        float respawnDelay;   //    
-        bool  pendingRespawn; //   
-        float respawnTimer;   //  ð
+        float respawnDelay;   // 몇 초 후 리스폰할지
+        bool  pendingRespawn; // 리스폰 대기 중인지
+        float respawnTimer;   // 누적 시간
         float deadTimer = 0.0f;
     };
 
@@ -48,21 +51,22 @@ namespace monster_ecs {
         float attackCooldown{ 1.0f };
         float attackTimer{ 0.0f };
 
-        // Idle/Patrol/Return   Ÿ̸ӷ  (roamTimer ü)
+        // Idle/Patrol/Return 상태 유지 타이머로 사용 (roamTimer 대체)
         float idlePatrolTimer{ 0.f };
 
-        // ̵ /ӵ (roamDirX/Y ü)
+        // 이동 방향/속도 (roamDirX/Y 대체)
         float moveDirX{ 0.f };
         float moveDirY{ 0.f };
         float moveSpeed{ 0.f };
-        bool netSynced = false; //  ȭ
-        // ͺ RNG õ ()
+        bool netSynced = false; // 최초 동기화용
+        // 몬스터별 RNG 시드 (유지)
         uint32_t rng = 0x12345678u;
         float attackCd = 0.0f;
     };
 
+    // 프리팹 이름은 NameTable id 로 (몬스터마다 문자열 안 들고 있음)
     struct CPrefabName {
-        std::string name;
+        core::NameId id = core::kNoName;
     };
 
     enum class PlayerState {
@@ -10,11 +10,11 @@ namespace monster_ecs {
 
     }
 
-    //   ϳ ̱ ( )
+    // 랜덤 방향 하나 뽑기 (단위 벡터)
     void MonsterEnvironment::pick_random_walk_dir(float /*x*/, float /*y*/,
         float& outDx, float& outDy)
     {
-        // 0 ~ 2  
+        // 0 ~ 2π 랜덤 각도
         std::uniform_real_distribution<float> dist(0.f, 2.f * 3.1415926f);
         float angle = dist(rng_);
 
@@ -22,7 +22,7 @@ namespace monster_ecs {
         outDy = std::sin(angle);
     }
 
-    //  ̵ : AI Ʈ /ӵ 
+    // 몬스터 이동 설정: AI 컴포넌트에 방향/속도 기록
     void MonsterEnvironment::set_monster_move(Entity e,
         float dx, float dy,
         float speed)
@@ -14,25 +14,32 @@ namespace monster_ecs {
     class MonsterEnvironment {
 
     public:
-		//ݹ Լ
+		//콜백 함수들
         std::function<std::uint64_t(float, float, float)> findClosestPlayer;
         std::function<bool(std::uint64_t, float&, float&)> getPlayerPosition;
         std::function<void(std::uint64_t, std::uint64_t, int, int)> broadcastCombat;
-        std::function<void(std::uint64_t, float, float)> moveInAoi;
+        std::function<void(std::uint64_t, float, float, float, float)> moveInAoi;   // (id, x, y, vx, vy)
+        // (fromX, fromY, toX&, toY&): 충돌 맵 기준으로 목표를 고침 (벽 미끄러짐). 못 움직이면 false
+        std::function<bool(float, float, float&, float&)> resolveMove;
+        // (id, targetId, x, y, goalX&, goalY&): 추적 목표를 경로상 다음 웨이포인트로 바꿈. 경로 계산 중이면 false
+        std::function<bool(std::uint64_t, std::uint64_t, float, float, float&, float&)> steerTarget;
         std::function<void(uint64_t, monster_ecs::CAI::State)>  broadcastAiState;
         std::function<void(uint64_t, PlayerState st)>  broadcastPlayerState;
 
+        // (x, y): 어떤 플레이어 시야 창 안인지. 없거나 false 면 타겟 없는 몬스터는 이번 틱 동결
+        std::function<bool(float, float)> isObserved;
+
         std::function<void(uint64_t mid, float x, float y)> spawnInAoi;
         std::function<void(uint64_t mid)>                  removeFromAoi;
 
         std::function<void(uint64_t monsterId, int hp, int maxHp, int sp, int maxSp)> broadcastMonsterStat;
         std::function<void(uint64_t playerId, int hp, int maxHp, int sp, int maxSp)> broadcastPlayerStat;
         
-		//ʵĿ ÷̾   ݹ
+		//필드워커에게 플레이어 스탯을 얻어오는 콜백
         std::function<bool(uint64_t playerId, int& hp, int& maxHp, int& sp, int& maxSp)> getPlayerStats;
-		//ʵĿ ÷̾  ϴ ݹ
+		//필드워커에게 플레이어 스탯을 설정하는 콜백
         std::function<void(uint64_t playerId, int newHp, int newSp)> setPlayerStats;
-		//ʵĿ ÷̾   ݹ
+		//필드워커에게 플레이어 데미지를 입히는 콜백
         std::function<void(uint64_t playerId, int dmg)> applyPlayerDamage;
         MonsterEnvironment(MonsterWorld& world);
 
@@ -21,16 +21,16 @@ namespace monster_ecs {
         monsters.push_back(e);
 
         transform.add(e, { x, y });
-        stats.add(e, {  maxHp,  hp , maxSp,  sp,  atk,  def });                      // ⺻ 
+        stats.add(e, {  maxHp,  hp , maxSp,  sp,  atk,  def });                      // 기본 스탯
 
-        // ⼭ Ÿ 
+        // 여기서 타입 세팅
         monster_ecs::CMonsterTag tag{};
         tag.monsterType = monsterType;
         monsterTag.add(e, tag);
 
-        spawnInfo.add(e, { x, y });            // spawn ġ
-        aiComp.add(e, {});                     // ⺻ Idle
-        prefabNameComp.add(e, { prefab });     //  ̸
+        spawnInfo.add(e, { x, y });            // spawn 위치
+        aiComp.add(e, {});                     // 기본 Idle
+        prefabNameComp.add(e, { core::NameTable::instance().intern(prefab) });     // 프리팹 이름 (인턴 id)
 
         return e;
     }
@@ -42,11 +42,38 @@ namespace monster_ecs {
         spawnInfo.get(e).deadTimer = 0.f;
     }
 
+    void MonsterWorld::halt(Entity e, MonsterEnvironment& env)
+    {
+        auto& tr = transform.get(e);
+        if (tr.vx == 0.f && tr.vy == 0.f)
+            return;
+        // 멈춘 채로 다시 보이게 될 때 클라가 예전 속도로 외삽하지 않도록
+        tr.vx = 0.f;
+        tr.vy = 0.f;
+        if (env.moveInAoi)
+            env.moveInAoi(e, tr.x, tr.y, 0.f, 0.f);
+    }
+
     void MonsterWorld::update(float dt, MonsterEnvironment& env)
     {
         if (spawnSys_)
             spawnSys_->update(dt, *this, env);
 
+        // 아무 클라에도 안 보이는 곳의 한가한 몬스터는 동결 (시야 창이 보이는 반경보다 넓어서 클라는 못 느낌)
+        //  - 타겟이 있는 몬스터는 추격/전투 마무리를 위해 계속 돌림
+        awake.clear();
+        for (Entity e : monsters) {
+            if (!env.isObserved || aiComp.get(e).targetId != 0) {
+                awake.push_back(e);
+                continue;
+            }
+            const auto& tr = transform.get(e);
+            if (env.isObserved(tr.x, tr.y))
+                awake.push_back(e);
+            else
+                halt(e, env);
+        }
+
         if (aiSys_)
             aiSys_->update(dt, *this, env);
 
@@ -57,6 +84,19 @@ namespace monster_ecs {
             combatSys_->update(dt, *this, env);
     }
 
+    void MonsterWorld::update_hibernated(float dt, MonsterEnvironment& env)
+    {
+        awake.clear();
+        if (spawnSys_)
+            spawnSys_->update(dt, *this, env);
+    }
+
+    void MonsterWorld::halt_all(MonsterEnvironment& env)
+    {
+        for (Entity e : monsters)
+            halt(e, env);
+    }
+
     bool MonsterWorld::player_attack_monster(uint64_t pid, uint64_t mid, game::SkillType skillType, MonsterEnvironment& env)
     {
         for (auto e : monsters)
@@ -71,15 +111,15 @@ namespace monster_ecs {
             {
                 st.hp = 0;
 
-                //  ó
+                // 죽음 처리
                 kill_monster(e);
 
-                //   ON (SpawnSystem  ʿ)
+                // 리스폰 대기 ON (SpawnSystem이 보려면 필요)
                 auto& sp = spawnInfo.get(e);
                 sp.pendingRespawn = true;
                 sp.respawnTimer = 0.0f;
 
-                // AOI  (Ŭ Leave  Destroy)
+                // AOI에서 제거 (클라에 Leave 나가서 Destroy됨)
                 if (env.removeFromAoi)
                     env.removeFromAoi(e);
 
@@ -4,8 +4,8 @@
 #include "Components.h"
 #include "core_types.h"
 #include "MonsterEnvironment.h"
-#include "proto/generated/field_generated.h" // FieldCmd, Vec2 
-#include "proto/generated/game_generated.h" // FieldCmd, Vec2 
+#include "proto/generated/field_generated.h" // FieldCmd, Vec2 등
+#include "proto/generated/game_generated.h" // FieldCmd, Vec2 등
 
 namespace monster_ecs {
 
@@ -15,7 +15,7 @@ namespace monster_ecs {
     class MovementSystem;
     class CombatSystem;
 
-    using Entity = std::uint64_t;   // ?? databaseid ״ Entity 
+    using Entity = std::uint64_t;   // ?? databaseid를 그대로 Entity로 사용
 
     static field::AiStateType to_fb_state(monster_ecs::CAI::State s)
     {
@@ -39,7 +39,12 @@ namespace monster_ecs {
             , int maxHp, int hp, int maxSp, int sp, int atk, int def);
 
         void kill_monster(Entity e);
+        // 리스폰은 전부, AI/이동/전투는 관찰 중(플레이어 시야 창 안)이거나 타겟이 있는 몬스터만
         void update(float dt, MonsterEnvironment& env);
+        // 필드에 아무도 없을 때: 리스폰 타이머만 진행
+        void update_hibernated(float dt, MonsterEnvironment& env);
+        // 전부 멈춤 (이동 중이던 몬스터는 AOI 에 속도 0 을 한 번 알림)
+        void halt_all(MonsterEnvironment& env);
         bool player_attack_monster(uint64_t pid, uint64_t targetid, game::SkillType skillType, MonsterEnvironment& env);
 
         // ================= Components =================
@@ -51,8 +56,11 @@ namespace monster_ecs {
         ComponentStorage<CPrefabName> prefabNameComp;
 
         std::vector<Entity> monsters;
+        std::vector<Entity> awake;      // 이번 틱 AI/이동/전투 대상 (update 에서 채움)
 
     private:
+        void halt(Entity e, MonsterEnvironment& env);
+
         SpawnSystem* spawnSys_;
         AISystem* aiSys_;
         MovementSystem* moveSys_;
@@ -15,15 +15,15 @@ inline float clampf(float v, float lo, float hi) {
     return (v < lo) ? lo : (v > hi) ? hi : v;
 }
 
-// Python env FsmMeleeEnvV2._obs() ״
+// Python env FsmMeleeEnvV2._obs() 그대로
 inline void MakeObs16(
     float outObs[16],
     bool hasTarget,
     float mx, float my,
     float tx, float ty,
     float m_hp, float m_max_hp,
-    float m_attack_cd,              //   Ÿ().  0 ־ (ǰ)
-    RLState last_action,            //  (Idle~Return)
+    float m_attack_cd,              // 서버의 공격 쿨타임(초). 없으면 0 넣어도 됨(품질↓)
+    RLState last_action,            // 직전 상태(Idle~Return)
     const ObsParams& p
 ) {
     for (int i = 0; i < 16; ++i) outObs[i] = 0.0f;
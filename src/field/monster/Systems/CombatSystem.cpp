@@ -6,19 +6,19 @@ namespace monster_ecs {
 
     void CombatSystem::update(float dt, MonsterWorld& ecs, MonsterEnvironment& env)
     {
-        for (Entity e : ecs.monsters) {
+        for (Entity e : ecs.awake) {
             auto& ai = ecs.aiComp.get(e);
             
             if (ai.state != CAI::State::Attack) {
-                //  ° ƴϸ Ÿ̸ ʱȭ
+                // 공격 상태가 아니면 타이머 초기화
                 ai.attackTimer = 0.0f;
                 continue;
             }
 
-            //  Ÿ 
+            // 공격 쿨타임 누적
             ai.attackTimer += dt;
             if (ai.attackTimer < ai.attackCooldown) {
-                //    á н
+                // 아직 쿨 안 찼으면 패스
                 continue;
             }
 
@@ -30,15 +30,15 @@ namespace monster_ecs {
             int damage = st.atk;
 			
 
-            // HP   env.broadcastCombat ȿ ó
+            // HP 깎는 건 env.broadcastCombat 안에서 처리
 			attack_player(e, ai.targetId, ecs, env);
             ai.attackCd = 0.9f;
 
-            // Ÿ 
+            // 쿨타임 리셋
             ai.attackTimer = 0.0f;
 
-            //  Chase  ʰ Attack ص 
-            // Ÿ ־ AISystem ʿ Attack -> Chase  ٲٴ  
+            // 굳이 Chase로 돌리지 않고 Attack 유지해도 됨
+            // 거리가 멀어지면 AISystem 쪽에서 Attack -> Chase 로 바꾸는 편이 깔끔
             // ai.state = CAI::State::Chase;
         }
     }
@@ -51,7 +51,7 @@ namespace monster_ecs {
         if (!env_.getPlayerStats(playerId, hp, maxHp, sp, maxSp))
             return; // invalid
 
-        // ===   ===
+        // === 데미지 계산 ===
         auto& mon = monsterWorld_.stats.get(monsterId);
         int dmg = mon.atk;
 
@@ -7,29 +7,46 @@ namespace monster_ecs {
 
     void MovementSystem::update(float dt, MonsterWorld& ecs, MonsterEnvironment& env)
     {
-        for (Entity e : ecs.monsters) {
+        for (Entity e : ecs.awake) {
             auto& ai = ecs.aiComp.get(e);
             auto& tr = ecs.transform.get(e);
 
-            //  ´   (Idle ǥ ϴ  ⼭ )
+            // 멈춤: 움직이던 중이었으면 AOI 에 속도 0 을 한 번 알림 (클라 외삽 정지)
+            auto halt = [&]() {
+                if (tr.vx != 0.f || tr.vy != 0.f) {
+                    tr.vx = 0.f;
+                    tr.vy = 0.f;
+                    env.moveInAoi(e, tr.x, tr.y, 0.f, 0.f);
+                }
+            };
+
+            // 정지 상태는 무조건 정지 (Idle에서도 좌표 변하는 문제 여기서 차단)
             if (ai.state == CAI::State::Idle ||
                 ai.state == CAI::State::Attack ||
                 ai.state == CAI::State::Dead)
             {
                 if (ai.moveSpeed != 0.f || ai.moveDirX != 0.f || ai.moveDirY != 0.f)
                     stop_move(e, ai, env);
+                halt();
                 continue;
             }
 
             float dirX = 0.f, dirY = 0.f;
             float speed = ai.moveSpeed;
 
-            // Chase Ÿ  ̵ (⼭ ǥ !)
+            // Chase는 타겟을 향해 이동 (여기서만 좌표 적분!)
             if (ai.state == CAI::State::Chase) {
                 float px, py;
                 if (!ai.targetId || !env.getPlayerPosition(ai.targetId, px, py)) {
-                    // Ÿ  ̵ 
+                    // 타겟 없으면 이동 중지
                     stop_move(e, ai, env);
+                    halt();
+                    continue;
+                }
+
+                // 타겟까지 직선이 막혔으면 경로의 다음 웨이포인트로 (경로 계산 중이면 제자리 대기)
+                if (env.steerTarget && !env.steerTarget(e, ai.targetId, tr.x, tr.y, px, py)) {
+                    halt();
                     continue;
                 }
 
@@ -38,41 +55,54 @@ namespace monster_ecs {
                 float len2 = dx * dx + dy * dy;
                 if (len2 < 1e-6f) {
                     stop_move(e, ai, env);
+                    halt();
                     continue;
                 }
                 float inv = 1.f / std::sqrt(len2);
                 dirX = dx * inv;
                 dirY = dy * inv;
 
-                // AI speed      ⺻ 
+                // AI가 speed 세팅 안 했을 수도 있으니 기본값 보정
                 if (speed <= 0.f) speed = 6.0f;
             }
-            // Patrol/Return AI   ̵
+            // Patrol/Return은 AI가 만들어둔 방향으로 이동
             else if (ai.state == CAI::State::Patrol || ai.state == CAI::State::Return) {
                 dirX = ai.moveDirX;
                 dirY = ai.moveDirY;
 
                 float len2 = dirX * dirX + dirY * dirY;
                 if (len2 < 1e-6f || speed <= 0.f) {
-                    // /ӵ  
+                    // 방향/속도 없으면 멈춤
                     stop_move(e, ai, env);
+                    halt();
                     continue;
                 }
             }
             else {
-                //    ¸ ϰ 
+                // 알 수 없는 상태면 안전하게 정지
                 stop_move(e, ai, env);
+                halt();
                 continue;
             }
 
-            //̵  (⼭ tr )
-            tr.x += dirX * speed * dt;
-            tr.y += dirY * speed * dt;
+            //이동 적용 (여기서만 tr 변경)
+            float nx = tr.x + dirX * speed * dt;
+            float ny = tr.y + dirY * speed * dt;
+
+            // 충돌 맵: 막히면 벽 따라 미끄러지고, 그것도 안 되면 이번 스텝은 제자리
+            if (env.resolveMove && !env.resolveMove(tr.x, tr.y, nx, ny)) {
+                halt();
+                continue;
+            }
 
-            // AOI  ̵ ýۿ
-            env.moveInAoi(e, tr.x, tr.y);
+            // AOI 갱신은 이동 시스템에서만 (속도 포함 -> 직선 이동 중엔 클라 외삽으로 Move 생략)
+            tr.vx = (nx - tr.x) / dt;
+            tr.vy = (ny - tr.y) / dt;
+            tr.x = nx;
+            tr.y = ny;
+            env.moveInAoi(e, tr.x, tr.y, tr.vx, tr.vy);
 
-            // ̵ɵ ֽ(Ŭ ̰  )
+            // 이동명령도 최신으로(클라가 이걸 쓰면 유용)
             ai.moveDirX = dirX;
             ai.moveDirY = dirY;
             ai.moveSpeed = speed;
@@ -12,11 +12,11 @@ namespace monster_ecs {
             auto& ai = ecs.aiComp.get(e);
             auto& tr = ecs.transform.get(e);
 
-            //   н
+            // 살아 있으면 패스
             if (st.hp > 0)
                 continue;
 
-            //    ƴϸ н
+            // 리스폰 대기 중이 아니면 패스
             if (!sp.pendingRespawn)
                 continue;
 
@@ -27,22 +27,22 @@ namespace monster_ecs {
             if (sp.respawnTimer < sp.respawnDelay)
                 continue;
 
-            // =====  =====
+            // ===== 리스폰 =====
             sp.pendingRespawn = false;
             sp.respawnTimer = 0.0f;
 
-            //  / ġ
+            // 스탯 / 위치
             st.hp = st.maxHp;
             tr.x = sp.spawnX;
             tr.y = sp.spawnY;
 
-            // AI ʱȭ
+            // AI 초기화
             ai.state = CAI::State::Idle;
             ai.targetId = 0;
             ai.thinkCooldown = 0.0f;
             ai.attackTimer = 0.0f;
 
-            // AOI  (Enter)
+            // AOI 재등장 (Enter)
             if (env.spawnInAoi)
                 env.spawnInAoi(e, tr.x, tr.y);
         }
@@ -17,13 +17,13 @@ namespace core {
     };
 
 
-    // ÷̾ ̵  (  ̵)
+    // 플레이어 이동 상태 (서버 권한 이동용)
     struct PlayerMoveState
     {
-        Vec2     dir{ 0.0f, 0.0f };  //  Է (ȭ)
-        bool     moving{ false };    // ̵  
-        float    speed{ PLAYER_SPEED };      // / (ʿ  )
-        float    lastInputTime{ 0 }; //  ð
+        Vec2     dir{ 0.0f, 0.0f };  // 마지막 입력 방향(정규화)
+        bool     moving{ false };    // 이동 중인지 여부
+        float    speed{ PLAYER_SPEED };      // 유닛/초 (필요 시 변경)
+        float    lastInputTime{ 0 }; // 서버 시각
     };
 
     struct PlayerStat
@@ -60,7 +60,7 @@ namespace core {
         const std::string& prefab_name() const { return prefabName_; }
         void set_prefab_name(const std::string& p) { prefabName_ = p; }
 
-        // --- ġ  ---
+        // --- 위치 관련 ---
         void set_pos(float x, float y)
         {
             pos_.x = x;
@@ -71,14 +71,14 @@ namespace core {
         float x() const { return pos_.x; }
         float y() const { return pos_.y; }
 
-        // --- ̵   ---
+        // --- 이동 상태 관련 ---
         PlayerMoveState& move_state() { return moveState_; }
         const PlayerMoveState& move_state() const { return moveState_; }
 
         void set_speed(float s) { moveState_.speed = s; }
         void stop_move() { moveState_.moving = false; }
 
-        // --- /HP ---
+        // --- 스탯/HP ---
         const PlayerStat& stat() const { return stat_; }
         PlayerStat& player_stat() { return stat_; }
 
@@ -116,9 +116,9 @@ namespace core {
         std::shared_ptr<net::Session> session_;
         std::string                   name_;
         std::string                 prefabName_;
-        int                           fieldId_{ 0 }; // 0 =  ʵ 
-        Vec2                          pos_;          // ʵ  ġ
-        PlayerMoveState               moveState_;    // ̵ 
+        int                           fieldId_{ 0 }; // 0 = 아직 필드 없음
+        Vec2                          pos_;          // 필드 내 위치
+        PlayerMoveState               moveState_;    // 이동 상태
         PlayerStat                    stat_;
     };
 
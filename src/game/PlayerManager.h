@@ -14,18 +14,18 @@ namespace core {
             return inst;
         }
 
-        //   ÷̾ ã
+        // 세션 기준으로 플레이어 찾기
         Player::Ptr get_by_session(net::Session* sess);
 
-        // ID  ã
+        // ID 기준으로 찾기
         Player::Ptr get_by_id(uint64_t id);
 
-        // α  Player  + 
+        // 로그인 시 Player 생성 + 등록
         Player::Ptr create_player(uint64_t id,
             const std::string& name,
             std::shared_ptr<net::Session> sess);
 
-        // α׾ƿ/   
+        // 로그아웃/세션 끊김 시 제거
         void remove_by_session(net::Session* sess);
         void remove_by_id(uint64_t id);
 
@@ -1,4 +1,4 @@
-﻿
+
 #include <csignal>
 #include <thread>
 #include <chrono>
@@ -9,6 +9,7 @@
 #include "worker/FieldWorker.h"
 #include "worker/workerManager.h"
 #include "worker/codec.h"
+#include "worker/threadRole.h"
 #include "net/uv_utils.h"
 #include "net/session.h"
 #include "net/tcp_server.h"
@@ -17,6 +18,7 @@
 
 #include "core/monitor/monitor.h"
 #include "field/FieldManager.h"
+#include "field/PathService.h"
 #include "core/handlers/game_handler_registry.h"   // ★ 전체 게임 핸들러 등록
 #include "config/server_config.h"
 #include "storage/StorageSystem.h"
@@ -26,17 +28,20 @@ extern void test_redis_ping();
 uv_loop_t* loop = nullptr;
 struct ServerInitContext
 {
-    std::shared_ptr<core::Worker>      gameWorker;   // GameWorker
+    std::vector<std::shared_ptr<core::Worker>> gameWorkers;  // GameWorker 샤드들
     std::shared_ptr<core::FieldWorker> mainField;    // 대표 필드 (지금은 1000번)
-    std::vector<core::Worker*>         fieldWorkers; // 모니터링용
+    std::vector<std::shared_ptr<core::FieldWorker>> startupFields; // 시작 시점 필드 워커 (정보 출력용)
 };
-ServerInitContext SetupGameAndFields(core::Dispatcher& disp)
+ServerInitContext SetupGameAndFields(std::vector<std::unique_ptr<core::Dispatcher>>& disps, std::size_t shardCount)
 {
     ServerInitContext ctx;
 
-  // ----- GameWorker 생성 -----
-    core::CreateGameWorker();
-    ctx.gameWorker = core::GetGameWorker();   // shared_ptr<core::Worker>
+  // ----- GameWorker 샤드 생성 -----
+    if (!core::CreateGameWorkers(shardCount)) {
+        std::cout << "[Fatal] GameWorker 샤드 생성 실패\n";
+        return ctx;   // gameWorkers 가 비어 있으면 main 에서 종료
+    }
+    ctx.gameWorkers = core::GetGameWorkerShards();
 
   // ----- FieldManager 를 통해 필드 여러 개 생성 -----
     auto& fm = core::FieldManager::instance();
@@ -50,19 +55,29 @@ ServerInitContext SetupGameAndFields(core::Dispatcher& disp)
         std::cout << "[Fatal] FieldWorker(1000) 생성 실패\n";
     }
 
-  // 모니터링용 필드 워커 목록
-    if (field1000) ctx.fieldWorkers.push_back(field1000.get());
-    if (field2000) ctx.fieldWorkers.push_back(field2000.get());
-    if (field3000) ctx.fieldWorkers.push_back(field3000.get());
+  // 시작 시점 필드 워커 목록 (분할 필드는 리전 워커 전부). 정보 출력에만 쓰고,
+  // 이후 생기고 회수되는 채널은 ChannelKeeper 가 매번 FieldManager 에서 다시 열거
+    fm.for_each_field([&](const std::shared_ptr<core::FieldWorker>& fw) {
+        ctx.startupFields.push_back(fw);
+        });
 
   // 대표 필드 하나 (라우팅용, 나중에 player->field_id 로 교체 예정)
     ctx.mainField = field1000;
 
-  // ----- GameWorker on_message 설정 -----
-    if (ctx.gameWorker) {
+  // ----- 샤드별 Dispatcher + on_message 설정 -----
+  //  - 디스패처 상태는 샤드마다 따로 (샤드 간 공유 없음)
+    disps.clear();
+    for (auto& gw : ctx.gameWorkers) {
+        disps.push_back(std::make_unique<core::Dispatcher>());
+        core::Dispatcher* disp = disps.back().get();
+
+  // ----- 게임 패킷 핸들러 등록 -----
+  //  (Ping, Login, EnterField 등은 전부 game_handlers 쪽에서 등록)
+        handlers::RegisterAllGameHandlers(*disp);
+
         auto fw = ctx.mainField; // 대표 필드 워커 캡처 (임시 라우팅용)
 
-        ctx.gameWorker->set_on_message([&disp, fw](const core::NetMessage& msg) {
+        gw->set_on_message([disp, fw](const core::NetMessage& msg) {
             if (msg.type != core::MessageType::NetEnvelope)
                 return;
             if (!msg.session)
@@ -84,7 +99,7 @@ ServerInitContext SetupGameAndFields(core::Dispatcher& disp)
             case game::MsgType_EnterField:
             case game::MsgType_SkillCmd:
               // 시스템/로그인/필드입장 등 GameWorker 레벨 처리
-                disp.dispatch(*env, msg.session.get());
+                disp->dispatch(*env, msg.session.get());
                 break;
 
             default:
@@ -97,13 +112,19 @@ ServerInitContext SetupGameAndFields(core::Dispatcher& disp)
             });
     }
 
-  // ----- 게임 패킷 핸들러 등록 -----
-  //  (Ping, Login, EnterField 등은 전부 game_handlers 쪽에서 등록)
-    handlers::RegisterAllGameHandlers(disp);
-
     return ctx;
 }
 
+// 필드 워커 큐 상태. 매번 FieldManager 에서 다시 열거하므로 새 채널도 보이고,
+// 회수된 워커는 목록에서 빠짐 (열거 중에는 for_each_field 가 shared_ptr 로 잡고 있음)
+static void LogFieldWorkerQueues()
+{
+    core::FieldManager::instance().for_each_field([](const std::shared_ptr<core::FieldWorker>& fw) {
+        std::cout << "[FieldQueue] " << fw->name()
+            << " queue=" << fw->GetMessageCount()
+            << " players=" << fw->player_count() << "\n";
+        });
+}
 
 int main() {
     // ----- 신호 처리 등록 -----
@@ -114,14 +135,58 @@ int main() {
     net::Loop io_loop;
     loop = io_loop.get();   // 전역 loop 사용
 
-    // ----- 디스패처 -----
-    core::Dispatcher disp;
+    // ----- 설정 로드 (GameWorker 샤드 수 등) -----
+    config::ServerConfig cfg;
+    std::string err;
+
+    std::string cfgPath = GetExeDir() + "config.json";
+
+    if (!config::LoadServerConfig(cfgPath, cfg, &err)) {
+        std::cout << "[Config] load failed: " << err << "\n";
+        return 1;
+    }
+
+    // ----- 스레드 역할/CPU 배치 (워커 생성 전에) -----
+    auto& threadRoles = core::ThreadRoleRegistry::instance();
+    threadRoles.configure(cfg.threads);
+    threadRoles.apply_current(core::ThreadRole::Io, "IoLoop");
+
+    // 틱 스레드 수는 필드 생성 전에 (필드 메모리를 담당 틱 스레드 노드에 잡기 위해)
+    const int tick_threads = 3;
+    threadRoles.set_tick_slots(tick_threads);
+
+    // ----- 필드 설정 (create_field 전에) -----
+    core::FieldManager::instance().configure(cfg.field);
+    // 몬스터 경로 탐색 스레드 (필드 틱에서 요청만 넣고 결과는 다음 틱에)
+    core::PathService::instance().start(cfg.field.path.threads);
+
+    // ----- 디스패처 (GameWorker 샤드별) -----
+    std::vector<std::unique_ptr<core::Dispatcher>> disps;
 
     // ----- 게임/필드/핸들러 초기화 -----
-    auto init = SetupGameAndFields(disp);
-    auto gameWorker = init.gameWorker;
+    auto init = SetupGameAndFields(disps, cfg.game.worker_shards);
+    if (init.gameWorkers.empty()) {
+        core::PathService::instance().stop();
+        return 1;
+    }
+    auto& gameWorkers = init.gameWorkers;
+    auto gameWorker = gameWorkers.empty() ? nullptr : gameWorkers.front();
     auto fieldWorker = init.mainField;
-    auto& fieldWorkers = init.fieldWorkers;   // 모니터링용
+
+    std::vector<core::Dispatcher*> shardDisps;
+    std::vector<core::Worker*>     shardWorkers;
+    for (auto& d : disps)       shardDisps.push_back(d.get());
+    for (auto& w : gameWorkers) shardWorkers.push_back(w.get());
+
+    // 모니터링: 0번 샤드는 GameWorker 칸, 나머지 샤드는 워커 목록에 같이 표시
+    //  - 큐 모니터에는 프로세스 끝까지 사는 샤드만 넘김 (필드 워커는 채널 회수로 사라질 수 있음)
+    std::vector<core::Worker*> monitoredWorkers(
+        shardWorkers.size() > 1 ? shardWorkers.begin() + 1 : shardWorkers.end(),
+        shardWorkers.end());
+
+    // 시작 정보 출력용 (init.startupFields 가 shared_ptr 로 잡고 있음)
+    std::vector<core::Worker*> infoWorkers(monitoredWorkers);
+    for (auto& fw : init.startupFields) infoWorkers.push_back(fw.get());
 
     // ----- TcpServer 생성 및 시작 -----
     const char* listen_ip = "127.0.0.1";
@@ -131,41 +196,35 @@ int main() {
         loop,
         listen_ip,
         listen_port,
-        &disp,
-        gameWorker ? gameWorker.get() : nullptr  // ★ GameWorker 넘겨줌
+        shardDisps,
+        shardWorkers  // ★ GameWorker 샤드들 넘겨줌
     );
     server.start();
 
 	// ----- 스토리지 시스템 시작 -----
 	test_redis_ping(); // Redis 연결 테스트
-    config::ServerConfig cfg;
-    std::string err;
-
-    std::string cfgPath = GetExeDir() + "config.json";
-
-    if (!config::LoadServerConfig(cfgPath, cfg, &err)) {
-        std::cout << "[Config] load failed: " << err << "\n";
-        return 1;
-    }
     auto storageSys = storage::StorageSystem::Create(loop, cfg);
     storageSys.start();
     // ----- TickWorkers (게임 틱 워커) -----
-    const int   tick_threads = 3;
     const int   tick_ms = 50;           // 20Hz
     const float tick_dt = tick_ms / 1000.0f;
 
     core::TickWorkers game_workers(tick_threads, tick_ms);
 
     game_workers.on_tick([&](int idx) {
+        // 틱 스레드는 thread_pool 쪽에서 만들어지므로 첫 틱에서 이름/CPU 지정
+        static thread_local bool roleApplied = false;
+        if (!roleApplied) {
+            threadRoles.apply_current_tick(idx, "TickWorker_" + std::to_string(idx));
+            roleApplied = true;
+        }
+
         auto& fm = core::FieldManager::instance();
         fm.for_each_field([&](const std::shared_ptr<core::FieldWorker>& fw) {
             if (!fw) return;
 
-            // FieldWorker에 field_id() 같은 게 있다고 가정
-            const uint32_t fid = fw->field_id();
-
-            // 이 쓰레드 담당 필드만 처리
-            if ((fid % tick_threads) != (uint32_t)idx)
+            // 이 쓰레드 담당 필드만 처리 (생성 때 이 슬롯 CPU 에서 first-touch 됨)
+            if (core::FieldManager::tick_slot(fw->field_id(), fw->channel(), fw->region_count(), fw->region_index()) != idx)
                 return;
 
             fw->update_world(tick_dt);
@@ -179,14 +238,36 @@ int main() {
         tick_threads,
         tick_ms,
         gameWorker ? gameWorker.get() : nullptr,
-        fieldWorkers
+        infoWorkers
     );
 
     // ----- 큐 모니터 스레드 시작 -----
     std::thread monitor_thread = StartWorkerQueueMonitor(
         gameWorker ? gameWorker.get() : nullptr,
-        fieldWorkers
+        monitoredWorkers
     );
+    threadRoles.apply(monitor_thread.native_handle(), core::ThreadRole::Monitor, "QueueMonitor");
+
+    // ----- 필드 채널 정리 스레드 -----
+    //  - 1초마다 남는 채널 drain / 빈 채널 회수 (워커 stop 포함이라 I/O 루프에서 돌리지 않음)
+    //  - 5초마다 필드 워커 큐 상태 (동적 채널 포함)
+    std::thread channel_thread([] {
+        auto nextChannelCheck = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        auto nextQueueLog = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (g_running.load()) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= nextChannelCheck) {
+                core::FieldManager::instance().update_channels();
+                nextChannelCheck = now + std::chrono::seconds(1);
+            }
+            if (now >= nextQueueLog) {
+                LogFieldWorkerQueues();
+                nextQueueLog = now + std::chrono::seconds(5);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        });
+    threadRoles.apply(channel_thread.native_handle(), core::ThreadRole::Monitor, "ChannelKeeper");
 
     // ----- 메인 루프 -----
     while (g_running.load()) {
@@ -198,12 +279,15 @@ int main() {
 
     if (monitor_thread.joinable())
         monitor_thread.join();
+    if (channel_thread.joinable())
+        channel_thread.join();
 
     // Flush stop -> DB stop
      storageSys.stop();
 
     // ----- 종료 정리 -----
     core::FieldManager::instance().stop_all();
+    core::PathService::instance().stop();
     core::WorkerManager::instance().stop_all();
 
     std::cout << "[Server] All workers stopped. Bye.\n";
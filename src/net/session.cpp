@@ -11,6 +11,35 @@
 
 namespace net {
 
+    SendBufferPool::Stats& SendBufferPool::stats() {
+        static Stats s;
+        return s;
+    }
+
+    std::vector<std::uint8_t> SendBufferPool::take() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (!spare_.empty()) {
+                std::vector<std::uint8_t> buf = std::move(spare_.back());
+                spare_.pop_back();
+                stats().reuses.fetch_add(1, std::memory_order_relaxed);
+                return buf;
+            }
+        }
+        stats().misses.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+
+    void SendBufferPool::give(std::vector<std::uint8_t>&& buf) {
+        if (buf.capacity() == 0 || buf.capacity() > kMaxKeepBytes) return;
+
+        buf.clear();
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (spare_.size() < kMaxSpare) {
+            spare_.push_back(std::move(buf));
+        }
+    }
+
     Session::Session(uv_loop_t* loop, core::Dispatcher* disp)
         : loop_(loop)
         , dispatcher_(disp)
@@ -24,15 +53,15 @@ namespace net {
 
         recv_buf_.reserve(64 * 1024);
 
-        // ? send async ʱȭ (loop thread ȣ)
+        // ? send async 초기화 (loop thread에서 호출됨)
         send_async_.data = this;
         uv_async_init(loop_, &send_async_, &Session::on_send_async);
     }
 
     Session::~Session() {
-        // uv_close ۿ óѴٰ  ⼱ Ư uv_close  
-        // ٸ, session ıǱ  send_async_ closeǾ .
-        // (   /   ϵ )
+        // uv_close는 밖에서 처리한다고 했으니 여기선 특별히 uv_close 안 함
+        // 다만, session이 파괴되기 전에 send_async_가 close되어야 안전함.
+        // (현재 구조에서 서버 종료/세션 종료 시점에 정리하도록 권장)
     }
 
     uv_stream_t* Session::stream() {
@@ -43,7 +72,7 @@ namespace net {
         uv_read_start(stream(), &Session::alloc_cb, &Session::read_cb);
     }
 
-    // ====== libuv ݹ ======
+    // ====== libuv 콜백들 ======
 
     void Session::alloc_cb(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
         auto* self = reinterpret_cast<Session*>(handle->data);
@@ -71,9 +100,9 @@ namespace net {
             uv_read_stop(stream());
             closing_ = true;
 
-            // () async ݾƾ    پ
-            // send_async_ loop thread closeǾ 
-            //  on_read loop thread OK
+            // (선택) async도 닫아야 세션 수명 문제가 줄어듦
+            // send_async_는 loop thread에서 close되어야 함
+            // 여기 on_read는 loop thread라 OK
             uv_close(reinterpret_cast<uv_handle_t*>(&send_async_), nullptr);
 
             uv_close(reinterpret_cast<uv_handle_t*>(&client_), &Session::close_cb);
@@ -104,12 +133,21 @@ namespace net {
                 core::NetMessage msg;
                 msg.session = shared_from_this();
                 msg.payload.assign(payload, payload + len);
+                msg.recvTime = std::chrono::steady_clock::now();
 
                 if (state_ == SessionState::InField) {
                     if (IsSkillEnvelope(payload, len)) {
-                        msg.type = core::MessageType::NetEnvelope;
-                        gameWorker_->push(std::move(msg));
-                        // std::cout << "[SV] Skill Envelope(InField) -> GameWorker\n";
+                        // 필드 안 스킬은 GameWorker를 거치지 않고 바로 소유 필드로
+                        if (auto fw = core::GetFieldWorker(fieldId_, player_id_)) {
+                            msg.type = core::MessageType::SkillEnvelope;
+                            fw->push(std::move(msg));
+                        }
+                        else {
+                            // 필드가 없으면 기존 경로(GameWorker -> Dispatcher)로
+                            msg.type = core::MessageType::NetEnvelope;
+                            gameWorker_->push(std::move(msg));
+                        }
+                        // std::cout << "[SV] Skill Envelope(InField) -> FieldWorker\n";
                     }
                     else if (IsFieldCmd(payload, len)) {
                         msg.type = core::MessageType::Custom;
@@ -150,15 +188,16 @@ namespace net {
     }
 
     // ============================================================
-    // ? send_payload: " 忡 ҷ "ϰ 
-    // - ⼭ uv_write  ȣ  
-    // - ť װ uv_async_send loop thread ñ
+    // ? send_payload: "어느 스레드에서 불려도 안전"하게 변경
+    // - 여기서는 uv_write 절대 호출 안 함
+    // - 큐에 쌓고 uv_async_send로 loop thread에 맡김
     // ============================================================
     void Session::send_payload(const std::uint8_t* payload, std::uint32_t len) {
         if (closing_) return;
         if (!payload || len == 0) return;
 
         PendingSend ps;
+        ps.buf = sendPool_->take();
         proto::Frame::write(ps.buf, payload, len);
 
         {
@@ -166,11 +205,26 @@ namespace net {
             send_q_.push_back(std::move(ps));
         }
 
-        // loop thread 
+        // loop thread 깨우기
+        uv_async_send(&send_async_);
+    }
+
+    void Session::send_frames(std::vector<std::uint8_t>&& frames) {
+        if (closing_) return;
+        if (frames.empty()) return;
+
+        PendingSend ps;
+        ps.buf = std::move(frames);
+
+        {
+            std::lock_guard<std::mutex> lock(send_mtx_);
+            send_q_.push_back(std::move(ps));
+        }
+
         uv_async_send(&send_async_);
     }
 
-    // loop thread ȣ
+    // loop thread에서 호출됨
     void Session::on_send_async(uv_async_t* h) {
         auto* self = reinterpret_cast<Session*>(h->data);
         if (!self || self->closing_) return;
@@ -189,6 +243,7 @@ namespace net {
         for (auto& ps : local) {
             auto* wr = new WriteReq{};
             wr->buf = std::move(ps.buf);
+            wr->pool = sendPool_;
             wr->req.data = wr;
 
             uv_buf_t b = uv_buf_init(
@@ -203,15 +258,16 @@ namespace net {
                 1,
                 [](uv_write_t* req, int status) {
                     auto* w = reinterpret_cast<WriteReq*>(req->data);
-                    // status < 0̸ α ܵ 
+                    // status < 0이면 로그 남겨도 됨
+                    w->pool->give(std::move(w->buf));
                     delete w;
                 }
             );
 
             if (r < 0) {
-                // uv_write ü ϸ ݹ     ⼭ 
+                // uv_write 자체가 실패하면 콜백이 안 올 수 있으니 여기서 정리
                 delete wr;
-                // ϸ α
+                // 원하면 로그
                 // std::cout << "[SV] uv_write failed: " << uv_strerror(r) << "\n";
             }
         }
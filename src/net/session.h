@@ -1,5 +1,6 @@
 #pragma once
 #include <uv.h>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <deque>
@@ -12,16 +13,42 @@
 #include "core/ids.h"
 
 namespace core {
-    class Worker;   //  GameWorker Ϳ  
+    class Worker;   // ★ GameWorker 포인터용 전방 선언
 }
 
 namespace net {
 
+    // ============================================================
+    // SendBufferPool
+    //  - 송신 버퍼 재활용: 보내는 쪽(필드 스레드 등)이 take() 로 꺼내 프레임을 바로 쓰고,
+    //    loop 스레드가 uv_write 완료 후 give() 로 돌려줌 (용량 유지 -> 평상시 할당 없음)
+    //  - WriteReq 가 shared_ptr 로 같이 들고 있어 세션이 먼저 사라져도 안전
+    // ============================================================
+    class SendBufferPool {
+    public:
+        struct Stats {
+            std::atomic<std::uint64_t> reuses{ 0 };   // 보관 버퍼로 처리
+            std::atomic<std::uint64_t> misses{ 0 };   // 빈 버퍼를 새로 줌 (첫 채움에서 할당)
+        };
+
+        std::vector<std::uint8_t> take();
+        void give(std::vector<std::uint8_t>&& buf);
+
+        static Stats& stats();
+
+    private:
+        static constexpr std::size_t kMaxSpare = 4;
+        static constexpr std::size_t kMaxKeepBytes = 64 * 1024;   // 이보다 크게 자란 버퍼는 버림
+
+        std::mutex mtx_;
+        std::vector<std::vector<std::uint8_t>> spare_;
+    };
+
 
     enum class SessionState {
-        Connected,   // Ӹ   (α )
-        LoggedIn,    // α  (ʵ  )
-        InField,     // ʵ ȿ  
+        Connected,   // 접속만 된 상태 (로그인 전)
+        LoggedIn,    // 로그인 성공 (필드 입장 전)
+        InField,     // 필드 안에 들어간 상태
     };
 
     class Session : public std::enable_shared_from_this<Session> {
@@ -35,17 +62,22 @@ namespace net {
         uv_stream_t* stream();
 
         void send_payload(const std::uint8_t* payload, std::uint32_t len);
-        // TcpServer ϴ ݹ
+        // 이미 [len][payload] 로 이어 붙인 프레임 묶음을 한 번에 전송 (uv_write 1회)
+        void send_frames(std::vector<std::uint8_t>&& frames);
+        // send_frames 용 버퍼 (비어 있고 이전 용량 유지). 채워서 send_frames 로 넘김
+        std::vector<std::uint8_t> take_send_buffer() { return sendPool_->take(); }
+        // TcpServer에서 등록하는 콜백
         void set_on_close(OnClose cb) { on_close_ = std::move(cb); }
 
-        //  GameWorker  (TcpServer    ȣ)
+        // ★ GameWorker 설정 (TcpServer에서 세션 생성 시 호출)
         void set_game_worker(core::Worker* w) { gameWorker_ = w; }
+        void set_dispatcher(core::Dispatcher* d) { dispatcher_ = d; }
         // ID / PlayerID
         std::uint64_t session_id() const { return id_; }
         void          set_player_id(std::uint64_t pid) { player_id_ = pid; }
         std::uint64_t player_id() const { return player_id_; }
 
-        //   / ʵ ID
+        // ★ 상태 / 필드 ID
         void         set_state(SessionState s) { state_ = s; }
         SessionState state() const { return state_; }
 
@@ -53,7 +85,7 @@ namespace net {
         int  field_id() const { return fieldId_; }
 
     private:
-        // -----  ݹ -----
+        // ----- 기존 콜백들 -----
         static void alloc_cb(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf);
         static void read_cb(uv_stream_t* s, ssize_t nread, const uv_buf_t* buf);
         static void close_cb(uv_handle_t* handle);
@@ -62,7 +94,7 @@ namespace net {
         void on_closed();
 
     private:
-        // ? ۽ loop  ѱ  
+        // ? 송신을 loop 스레드로 넘기기 위한 구조
         struct PendingSend {
             std::vector<std::uint8_t> buf;
         };
@@ -70,6 +102,7 @@ namespace net {
         struct WriteReq {
             uv_write_t req{};
             std::vector<std::uint8_t> buf;
+            std::shared_ptr<SendBufferPool> pool;
         };
 
         static void on_send_async(uv_async_t* h);
@@ -88,15 +121,16 @@ namespace net {
         uv_async_t send_async_{};
         std::mutex send_mtx_;
         std::deque<PendingSend> send_q_;
+        std::shared_ptr<SendBufferPool> sendPool_ = std::make_shared<SendBufferPool>();
 
-        // ()   ȣ
+        // (선택) 종료 중 보호
         bool closing_{ false };
 
     private:
         std::uint64_t    id_{ 0 };
         std::uint64_t    player_id_{ 0 };
 
-        //   ߰
+        // ★ 여기 추가
         SessionState     state_{ SessionState::Connected };
         int              fieldId_{ 0 };
 
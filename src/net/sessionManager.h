@@ -16,7 +16,7 @@ namespace net {
             return inst;
         }
 
-        //    
+        // 접속 직후 세션 등록
         void add_session(const Session::Ptr& sess) {
             if (!sess) return;
             std::lock_guard<std::mutex> lock(mutex_);
@@ -24,12 +24,12 @@ namespace net {
             sessions_by_session_id_[sid] = sess;
         }
 
-        //   (  )
+        // 세션 제거 (연결 종료 시)
         void remove_session(std::uint64_t sessionId) {
             std::lock_guard<std::mutex> lock(mutex_);
             sessions_by_session_id_.erase(sessionId);
 
-            // playerId ε 
+            // playerId 매핑도 정리
             for (auto it = sessions_by_player_id_.begin();
                 it != sessions_by_player_id_.end(); )
             {
@@ -47,7 +47,7 @@ namespace net {
             }
         }
 
-        // α/ĳͼ  playerId -> session binding
+        // 로그인/캐릭터선택 후 playerId -> session binding
         void bind_player(std::uint64_t playerId, const Session::Ptr& sess) {
             if (!sess) return;
             std::lock_guard<std::mutex> lock(mutex_);
@@ -67,7 +67,7 @@ namespace net {
             return it->second.lock();
         }
 
-        // AOI watcherId(playerId)  ã  
+        // AOI에서 watcherId(playerId)로 세션 찾을 때 사용
         Session::Ptr find_by_player_id(std::uint64_t playerId) {
             std::lock_guard<std::mutex> lock(mutex_);
             auto it = sessions_by_player_id_.find(playerId);
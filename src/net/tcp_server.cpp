@@ -3,21 +3,20 @@
 #include "net/uv_utils.h"
 #include "net/sessionManager.h"
 #include "core/Dispatcher.h"
-// ʿϸ Worker  ߰
-// #include "worker/worker.h"
+#include "worker/worker.h"
 
 namespace net {
 
     TcpServer::TcpServer(uv_loop_t* loop,
         const char* ip,
         int port,
-        core::Dispatcher* disp,
-        core::Worker* gameWorker)   //   ߰
+        std::vector<core::Dispatcher*> dispatchers,
+        std::vector<core::Worker*> gameWorkers)
         : loop_(loop)
         , ip_(ip)
         , port_(port)
-        , dispatcher_(disp)
-        , gameWorker_(gameWorker)                    //   ʱȭ
+        , dispatchers_(std::move(dispatchers))
+        , gameWorkers_(std::move(gameWorkers))
     {
         uv_tcp_init(loop_, &server_);
         server_.data = this;
@@ -37,18 +36,23 @@ namespace net {
     void TcpServer::on_new_conn(uv_stream_t* s, int status) {
         auto* self = reinterpret_cast<TcpServer*>(s->data);
         if (status < 0) {
-            // α 
+            // 로그 정도
             return;
         }
 
-        auto sess = std::make_shared<Session>(self->loop_, self->dispatcher_);
+        auto sess = std::make_shared<Session>(self->loop_, nullptr);
 
-        //  ⼭ GameWorker 
-        if (self->gameWorker_) {
-            sess->set_game_worker(self->gameWorker_);
+        // ★ 여기서 GameWorker 샤드 주입 (sessionId 기준으로 고정)
+        if (!self->gameWorkers_.empty()) {
+            const std::size_t shard =
+                core::GameShardIndex(sess->session_id(), self->gameWorkers_.size());
+
+            sess->set_game_worker(self->gameWorkers_[shard]);
+            if (shard < self->dispatchers_.size())
+                sess->set_dispatcher(self->dispatchers_[shard]);
         }
 
-        // close ݹ 
+        // close 콜백 등록
         sess->set_on_close([self](Session::Ptr closed) {
             SessionManager::instance().remove_session(closed->session_id());
             self->on_session_closed(closed);
@@ -56,14 +60,14 @@ namespace net {
 
         if (uv_accept(s, sess->stream()) == 0) {
             sess->start();
-			//÷̾ ̵ ӽ Ҵ
+			//플레이어 아이디 임시 할당
             sess->set_player_id(4);
 
             SessionManager::instance().add_session(sess);
             self->sessions_.push_back(sess);
         }
         else {
-            // accept   sess Ҹ
+            // accept 실패 → sess 소멸
         }
     }
 
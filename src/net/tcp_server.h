@@ -9,7 +9,7 @@
 #include "core/Dispatcher.h"
 
 namespace core {
-    class Worker;   //  
+    class Worker;   // 전방 선언
 }
 
 namespace net {
@@ -20,8 +20,8 @@ namespace net {
         TcpServer(uv_loop_t* loop,
             const char* ip,
             int port,
-            core::Dispatcher* disp,
-            core::Worker* gameWorker);   // GameWorker ߰
+            std::vector<core::Dispatcher*> dispatchers,   // GameWorker 샤드별 디스패처
+            std::vector<core::Worker*> gameWorkers);      // GameWorker 샤드들
 
         void start();
 
@@ -36,9 +36,8 @@ namespace net {
         uv_loop_t* loop_;
         const char* ip_;
         int               port_;
-        core::Dispatcher* dispatcher_;
-
-        core::Worker* gameWorker_;        // ߰
+        std::vector<core::Dispatcher*> dispatchers_;  // [shard]
+        std::vector<core::Worker*>     gameWorkers_;  // [shard]
 
         uv_tcp_t          server_;
         std::vector<Session::Ptr> sessions_;
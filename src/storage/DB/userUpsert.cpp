@@ -56,7 +56,7 @@ namespace storage::sql {
 
         // inv_json (TEXT/JSON)
         bind[5].buffer_type = MYSQL_TYPE_STRING;
-        bind[5].buffer = (void*)inv_ptr;         //   Ź 
+        bind[5].buffer = (void*)inv_ptr;         // 실행 전에 매번 갱신
         bind[5].buffer_length = 0;
         bind[5].length = &inv_len;
         bind[5].is_null = &inv_is_null;
@@ -84,11 +84,11 @@ namespace storage::sql {
                 bind[5].buffer_length = inv_len;
             }
 
-            // bind[5].buffer ٲ ٽ bindִ  (̹  ʿ)
+            // bind[5].buffer를 바꿨으니 다시 bind해주는 게 안전(드라이버에 따라 필요)
             if (mysql_stmt_bind_param(stmt, bind) != 0) { mysql_stmt_close(stmt); return false; }
 
             if (mysql_stmt_execute(stmt) != 0) {
-                // ⼭ mysql_stmt_error(stmt) α   
+                // 여기서 mysql_stmt_error(stmt) 로그 찍으면 디버깅 쉬움
                 mysql_stmt_close(stmt);
                 return false;
             }
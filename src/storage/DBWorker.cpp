@@ -1,4 +1,5 @@
 #include "storage/DBWorker.h"
+#include "worker/threadRole.h"
 namespace storage {
 
     DBWorker::DBWorker(Handler handler)
@@ -28,6 +29,8 @@ namespace storage {
     }
 
     void DBWorker::run() {
+        core::ThreadRoleRegistry::instance().apply_current(core::ThreadRole::Db, "DBWorker");
+
         while (true) {
             DbJob job;
             {
@@ -8,7 +8,7 @@ namespace storage {
 
     class DirtyHub {
     public:
-        static constexpr std::size_t kShards = 64; // 2  õ
+        static constexpr std::size_t kShards = 64; // 2의 제곱 추천
 
         void mark_dirty(std::uint64_t uid) {
             auto& shard = shards_[uid & (kShards - 1)];
@@ -16,11 +16,11 @@ namespace storage {
             shard.set.insert(uid);
         }
 
-        //  shard ļ 
+        // 모든 shard를 합쳐서 가져감
         std::vector<std::uint64_t> steal_all() {
             std::vector<std::uint64_t> out;
-            // 1)  reserve (Ȯ ʿ   )
-            // 2) shard 񾿸 lock
+            // 1) 대충 reserve (정확도 필요 없으면 생략 가능)
+            // 2) shard별로 잠깐씩만 lock
             for (auto& s : shards_) {
                 std::lock_guard<std::mutex> lk(s.mu);
                 out.insert(out.end(), s.set.begin(), s.set.end());
@@ -10,7 +10,7 @@ namespace storage {
     }
 
     FlushWorkerUv::~FlushWorkerUv() {
-        // stop() ȣ   ä ıǴ  ġ
+        // stop()가 호출 안 된 채 파괴되는 경우 안전장치
         stop();
     }
 
@@ -23,7 +23,7 @@ namespace storage {
         DirtyHub dirty;
         DBWorker db;
         
-        // flush interval (cfg ⺻ ε)
+        // flush interval (cfg에서 기본값 로드)
         std::uint64_t interval_ms{ 2000 };
         Impl(uv_loop_s* l, const config::ServerConfig& c)
             : loop(l)
@@ -37,11 +37,11 @@ namespace storage {
             auto* self = static_cast<Impl*>(t->data);
             if (!self || !self->started.load()) return;
 
-            // 1) dirty 
+            // 1) dirty 스냅샷
             auto uids = self->dirty.steal_all();
             if (uids.empty()) return;
 
-            // 2) DB  push
+            // 2) DB 스레드로 push
             DbJob job;
             job.uids = std::move(uids);
             self->db.push(std::move(job));
@@ -75,8 +75,8 @@ namespace storage {
             return start(cfg.storage.flush_interval_ms);
         }
         void handle_db_job(const DbJob& job) {
-            // cfg  
-            // TODO: ⼭ Redis pipeline + MySQL upsert
+            // cfg 사용 가능
+            // TODO: 여기서 Redis pipeline + MySQL upsert
             std::cout << "[DBWorker] flush batch size=" << job.uids.size()
                 << " flush_ms=" << cfg.storage.flush_interval_ms << "\n";
         }
@@ -90,7 +90,7 @@ namespace storage {
     StorageSystem& StorageSystem::operator=(StorageSystem&&) noexcept = default;
     StorageSystem StorageSystem::Create(uv_loop_s* loop, const config::ServerConfig& cfg) {
         StorageSystem ss;
-        ss.impl_ = std::make_unique<Impl>(loop, cfg); // cfg 
+        ss.impl_ = std::make_unique<Impl>(loop, cfg); // cfg 전달
         return ss;
     }
 
@@ -8,7 +8,7 @@ namespace storage {
 
     class DirtyHub;
 
-    // ܺο ̴ API
+    // 외부에 보이는 API만
     class StorageSystem {
     public:
         StorageSystem();
@@ -25,12 +25,12 @@ namespace storage {
         void start();
         void stop(); // flush stop -> db stop(join)
 
-        // FieldWorker Ƽ    ( ߿  Ʈ)
+        // FieldWorker에서 더티 찍을 때 사용 (가장 중요한 노출 포인트)
         DirtyHub& dirty();
 
     private:
         struct Impl;                 // PIMPL
-        std::unique_ptr<Impl> impl_; //  incomplete type  õ 
+        std::unique_ptr<Impl> impl_; // 헤더에서 incomplete type 문제 원천 차단
     };
 
 } // namespace storage
@@ -29,18 +29,18 @@ namespace storage::redis {
         if (!c) return false;
         if (uids.empty()) return true;
 
-        // 1) :  uid HMGET 1 + GET 1 = 2 Ŀǵ
+        // 1) 파이프라인: 각 uid마다 HMGET 1개 + GET 1개 = 2개 커맨드
         for (auto uid : uids) {
             const auto krt = KeyRt(uid);
             const auto kinv = KeyInv(uid);
 
-            // HMGET key x z hp sp  -> 迭 4
+            // HMGET key x z hp sp  -> 배열 4개
             redisAppendCommand(c, "HMGET %s x z hp sp", krt.c_str());
             // GET inv_json
             redisAppendCommand(c, "GET %s", kinv.c_str());
         }
 
-        // 2)  :   2 
+        // 2) 응답 수집: 같은 순서로 2개씩 꺼내기
         out.reserve(uids.size());
 
         for (auto uid : uids) {
@@ -65,7 +65,7 @@ namespace storage::redis {
                 if (ok) { s.x = x; s.z = z; s.hp = hp; s.sp = sp; }
             }
 
-            // GET inv reply ( NIL )
+            // GET inv reply (없으면 NIL 가능)
             if (r2) {
                 if (r2->type == REDIS_REPLY_STRING && r2->str) s.inv_json.assign(r2->str, r2->len);
                 else s.inv_json.clear();
@@ -74,7 +74,7 @@ namespace storage::redis {
             if (r1) freeReplyObject(r1);
             if (r2) freeReplyObject(r2);
 
-            if (ok) out.push_back(std::move(s)); // rt ȿ uid Ʈ
+            if (ok) out.push_back(std::move(s)); // rt가 유효한 uid만 업서트
         }
 
         return true;
@@ -13,11 +13,11 @@ namespace storage::redis {
         float z = 0.f;
         int hp = 0;
         int sp = 0;
-        std::string inv_json; //  ""
+        std::string inv_json; // 없으면 ""로
     };
 
-    // u:{uid}:rt  x,z,hp,sp а u:{uid}:inv  JSON б
-    //  uid out (Ű ų Ľ д ŵ)
+    // u:{uid}:rt 에서 x,z,hp,sp 읽고 u:{uid}:inv 에서 JSON 읽기
+    // 성공한 uid만 out에 들어감(키 없거나 파싱 실패는 스킵)
     bool FetchUsers(redisContext* c,
         const std::vector<std::uint64_t>& uids,
         std::vector<UserSnapshot>& out);
@@ -11,7 +11,7 @@ namespace proto {
     std::uint32_t Frame::read_len(const std::uint8_t* data) {
         std::uint32_t len;
         std::memcpy(&len, data, 4);
-        return len;   // little-endian ȯ(Windows/x64 ) 
+        return len;   // little-endian 환경(Windows/x64 등) 기준
     }
 
     void Frame::write(std::vector<std::uint8_t>& out,
@@ -28,7 +28,7 @@ namespace proto {
 
     bool verify_envelope(const std::uint8_t* buf, std::size_t len) {
         flatbuffers::Verifier verifier(buf, len);
-        //  Լ game_generated.h ȿ inline  Ǿ 
+        // 이 함수도 game_generated.h 안에 inline 으로 구현되어 있음
         return game::VerifyEnvelopeBuffer(verifier);
     }
 
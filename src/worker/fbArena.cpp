@@ -0,0 +1,67 @@
+#include "fbArena.h"
+
+namespace core {
+
+    FbArena::Stats& FbArena::stats()
+    {
+        static Stats s;
+        return s;
+    }
+
+    FbArena::FbArena()
+        : fbb_(kInitialSize, &alloc_, false)
+    {
+    }
+
+    FbArena& FbArena::local()
+    {
+        thread_local FbArena arena;
+        return arena;
+    }
+
+    flatbuffers::FlatBufferBuilder& FbArena::builder()
+    {
+        stats().builds.fetch_add(1, std::memory_order_relaxed);
+
+        auto& fbb = local().fbb_;
+        fbb.Clear();
+        return fbb;
+    }
+
+    FbArena::Allocator::~Allocator()
+    {
+        delete[] spare_;
+    }
+
+    std::uint8_t* FbArena::Allocator::allocate(std::size_t size)
+    {
+        // 빌더는 최대 크기 블록 하나만 쓰므로 보관 블록도 하나면 충분
+        if (spare_ && spareSize_ >= size) {
+            std::uint8_t* p = spare_;
+            spare_ = nullptr;
+            spareSize_ = 0;
+            stats().blockReuses.fetch_add(1, std::memory_order_relaxed);
+            return p;
+        }
+
+        Stats& st = stats();
+        st.heapAllocs.fetch_add(1, std::memory_order_relaxed);
+        st.heapBytes.fetch_add(size, std::memory_order_relaxed);
+        return new std::uint8_t[size];
+    }
+
+    void FbArena::Allocator::deallocate(std::uint8_t* p, std::size_t size)
+    {
+        if (!p) return;
+
+        // 더 큰 쪽을 남김
+        if (size > spareSize_) {
+            delete[] spare_;
+            spare_ = p;
+            spareSize_ = size;
+            return;
+        }
+        delete[] p;
+    }
+
+} // namespace core
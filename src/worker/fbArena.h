@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <flatbuffers/flatbuffers.h>
+
+namespace core {
+
+    // ====================================================================
+    // FbArena
+    //  - 송신 패킷 빌드용 FlatBufferBuilder 를 스레드마다 하나 두고 재사용
+    //  - builder() 는 Clear() 한 빌더를 돌려줌 (버퍼 용량은 유지 -> 평상시 할당 0)
+    //  - 빌더가 버퍼를 놓았다 다시 잡는 경우(Reset/성장)도 할당자가 블록 하나를 들고 있다가 다시 줌
+    //  - 한 번에 한 패킷만: 빌드 -> 전송(복사)까지 끝난 뒤 다음 builder() 호출
+    // ====================================================================
+    class FbArena {
+    public:
+        struct Stats {
+            std::atomic<std::uint64_t> builds{ 0 };       // builder() 호출 수
+            std::atomic<std::uint64_t> heapAllocs{ 0 };   // 빌더 버퍼 실제 new (0 에서 안 늘어야 정상)
+            std::atomic<std::uint64_t> heapBytes{ 0 };
+            std::atomic<std::uint64_t> blockReuses{ 0 };  // 들고 있던 블록으로 처리된 할당
+        };
+
+        static flatbuffers::FlatBufferBuilder& builder();
+
+        static Stats& stats();
+
+    private:
+        // 해제된 블록 하나를 보관했다가 다음 할당에 재사용하는 카운팅 할당자
+        class Allocator : public flatbuffers::Allocator {
+        public:
+            ~Allocator() override;
+
+            std::uint8_t* allocate(std::size_t size) override;
+            void deallocate(std::uint8_t* p, std::size_t size) override;
+
+        private:
+            std::uint8_t* spare_ = nullptr;
+            std::size_t   spareSize_ = 0;
+        };
+
+        FbArena();
+
+        static FbArena& local();
+
+        static constexpr std::size_t kInitialSize = 1024;
+
+        // 선언 순서 중요: 빌더가 할당자보다 먼저 파괴돼야 함
+        Allocator                      alloc_;
+        flatbuffers::FlatBufferBuilder fbb_;
+    };
+
+} // namespace core
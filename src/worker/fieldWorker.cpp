@@ -1,14 +1,17 @@
 // FieldWorker.cpp
 
 #include "fieldWorker.h"
+#include <limits>
 #include "workerManager.h"
+#include "worker/codec.h"
+#include "worker/fbArena.h"
 #include "net/session.h"
 #include "net/sessionManager.h"
 #include "field/FieldAoiSystem.h"
 #include "field/FieldManager.h"
 #include "game/PlayerManager.h"
-#include "proto/generated/field_generated.h" // FieldCmd, Vec2 
-#include "proto/generated/game_generated.h" // FieldCmd, Vec2 
+#include "proto/generated/field_generated.h" // FieldCmd, Vec2 등
+#include "proto/generated/game_generated.h" // FieldCmd, Vec2 등
 #include "field/monster/MonsterWorld.h"
 #include "field/monster/MonsterEnvironment.h"
 using net::SessionManager;
@@ -16,118 +19,197 @@ using net::SessionManager;
 namespace core {
 
     // --------------------------------------------------------------------
-    //  ƿ: FieldWorker ̸ 
+    // 내부 유틸: FieldWorker 이름 생성
     // --------------------------------------------------------------------
-    static std::string make_field_worker_name(int fieldId)
+    static std::string make_field_worker_name(int fieldId, const FieldRegionLayout& layout, int region, int channel)
     {
-        return "FieldWorker_" + std::to_string(fieldId);
+        std::string name = "FieldWorker_" + std::to_string(fieldId);
+        if (channel > 0)
+            name += "_c" + std::to_string(channel);
+        if (layout.partitioned())
+            name += "_r" + std::to_string(region);
+        return name;
     }
     static bool is_monster_id(std::uint64_t id)
     {
-        // װ  Ģ 缭 
+        // 네가 정한 규칙에 맞춰서 수정
         return id >= 1000;
     }
+    // 플레이어는 프리셋으로 Paladin 사용
+    static NameId player_prefab_id()
+    {
+        static const NameId id = NameTable::instance().intern("Paladin");
+        return id;
+    }
+    // 프리팹을 모를 때 클라가 쓰는 기본값
+    static const std::string& prefab_or_default(NameId id)
+    {
+        static const std::string kDefault = "Default";
+        const std::string& name = NameTable::instance().name(id);
+        return name.empty() ? kDefault : name;
+    }
 
     // --------------------------------------------------------------------
-    // 
+    // 생성자
     // --------------------------------------------------------------------
-    FieldWorker::FieldWorker(int fieldId)
-        : Worker(make_field_worker_name(fieldId))
+    FieldWorker::FieldWorker(int fieldId, const config::AoiConfig& aoiCfg,
+        const FieldRegionLayout& layout, int regionIndex, int channel, CollisionMap::Ptr collision,
+        const config::FieldPathConfig& pathCfg)
+        : Worker(make_field_worker_name(fieldId, layout, regionIndex, channel), ThreadRole::Field, /*ownThread=*/false)
         , fieldId_(fieldId)
         , monsterWorld_()
         , env_(monsterWorld_)
+        , layout_(layout)
+        , regionIndex_(regionIndex)
+        , channel_(channel)
+        , collision_(std::move(collision))
+        , repathDist_(pathCfg.repath_dist)
+        , hibernateAfter_(aoiCfg.hibernate_after_sec)
     {
+        // 분할 안 된 필드는 리전 0 이 필드 전체 (AOI 는 리전과 상관없이 필드 전체 크기로 잡음)
+        bounds_ = layout_.partitioned()
+            ? layout_.bounds(regionIndex_)
+            : RegionRect{ 0.0f, 0.0f, kFieldWidth, kFieldHeight };
+        mirrors_.resize(layout_.region_count());
+
+        if (collision_ && pathCfg.threads > 0) {
+            pathfinder_ = std::make_shared<FieldPathfinder>(collision_, pathCfg);
+            flowFields_ = std::make_shared<FieldFlowFields>(collision_, pathCfg);
+        }
+
         init_monster_env();
+        if (!aoiCfg.freeze_unobserved)
+            env_.isObserved = nullptr;
 
-        // 1) AOI ý 
-        aoiSystem_ = std::make_shared<FieldAoiSystem>(fieldId_, 15.0f, 2);
+        // 1) AOI 시스템 생성
+        aoiSystem_ = std::make_shared<FieldAoiSystem>(fieldId_, aoiCfg, kFieldWidth, kFieldHeight, PlayerStep);
+        prefabOnEnterOnly_ = aoiCfg.prefab_on_enter_only;
+        velocityInDir_ = aoiCfg.dead_reckoning && aoiCfg.dr_error_m > 0.0f;
 
-        // 2) ݹ 
-        aoiSystem_->set_send_func(
-            [this](std::uint64_t watcherId, const AoiEvent& ev)
-            {
-                auto sess = SessionManager::instance().find_by_player_id(watcherId);
-                if (!sess)
-                    return;
+        if (fieldId == 1000) {
+            SpawnMonstersEvenGrid(1000);
+        }
 
-                flatbuffers::FlatBufferBuilder fbb;
-                auto pos = field::CreateVec2(fbb, ev.position.x, ev.position.y);
-
-                field::FieldCmdType cmdType = field::FieldCmdType::FieldCmdType_Move;
-                switch (ev.type)
-                {
-                case AoiEvent::Type::Snapshot:
-                case AoiEvent::Type::Enter:
-                    cmdType = field::FieldCmdType::FieldCmdType_Enter;
-                    break;
-                case AoiEvent::Type::Leave:
-                    cmdType = field::FieldCmdType::FieldCmdType_Leave;
-                    break;
-                case AoiEvent::Type::Move:
-                    cmdType = field::FieldCmdType::FieldCmdType_Move;
-                    break;
-                }
+        // 마지막에 AOI 활성화
+        aoiSystem_->set_initialized(true);
+    }
 
-                bool isMonster = is_monster_id(ev.subjectId);
-                field::EntityType et = isMonster
-                    ? field::EntityType::EntityType_Monster
-                    : field::EntityType::EntityType_Player;
-
-                std::string prefabName = get_prefab_name(ev.subjectId, isMonster);
-                if (prefabName.empty())
-                    prefabName = "Default";
-
-                auto prefabStr = fbb.CreateString(prefabName);
-
-                auto cmd = field::CreateFieldCmd(
-                    fbb,
-                    cmdType,
-                    et,
-                    ev.subjectId,
-                    pos,
-                    0,
-                    prefabStr
-                );
 
-                auto envOffset = field::CreateEnvelope(
-                    fbb,
-                    field::Packet::Packet_FieldCmd,
-                    cmd.Union()
-                );
 
-                fbb.Finish(envOffset);
 
-                sess->send_payload(
-                    fbb.GetBufferPointer(),
-                    static_cast<std::uint32_t>(fbb.GetSize())
-                );
-            }
-        );
+    FieldWorker::~FieldWorker() = default;
+
+    // --------------------------------------------------------------------
+    // 틱 끝: 이번 틱에 쌓인 AOI 이벤트를 watcher 별로 묶어서 전송
+    //  - 세션 조회 1회 + 프레임을 이어 붙여 send 1회
+    // --------------------------------------------------------------------
+    void FieldWorker::flush_aoi_events()
+    {
+        if (!aoiSystem_) return;
 
-        set_on_message(
-            [this](const NetMessage& msg)
+        aoiSystem_->flush_events(
+            [&](std::uint64_t watcherId, const AoiEventBatch& batch)
             {
-                handle_message(msg);
+                auto sess = SessionManager::instance().find_by_player_id(watcherId);
+                if (!sess)
+                    return;
+
+                // 세션이 돌려준 버퍼에 바로 프레이밍 (용량 재사용)
+                std::vector<std::uint8_t> frames = sess->take_send_buffer();
+                frames.reserve(batch.size() * 64);
+
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    const AoiEvent ev = batch[i];
+
+                    auto& fbb = FbArena::builder();
+                    auto pos = field::CreateVec2(fbb, ev.position.x, ev.position.y);
+
+                    field::FieldCmdType cmdType = field::FieldCmdType::FieldCmdType_Move;
+                    switch (ev.type)
+                    {
+                    case AoiEvent::Type::Snapshot:
+                    case AoiEvent::Type::Enter:
+                        cmdType = field::FieldCmdType::FieldCmdType_Enter;
+                        break;
+                    case AoiEvent::Type::Leave:
+                        cmdType = field::FieldCmdType::FieldCmdType_Leave;
+                        break;
+                    case AoiEvent::Type::Move:
+                        cmdType = field::FieldCmdType::FieldCmdType_Move;
+                        break;
+                    }
+
+                    bool isMonster = is_monster_id(ev.subjectId);
+                    field::EntityType et = isMonster
+                        ? field::EntityType::EntityType_Monster
+                        : field::EntityType::EntityType_Player;
+
+                    // FieldCmd.prefab (클라 계약)
+                    //  - 기본: 모든 이벤트에 실음 (기존 클라 그대로)
+                    //  - prefab_on_enter_only: Enter 에만 실음. Move/Leave 는 prefab 이 비어 있고,
+                    //    클라는 Enter 때 받은 값을 id 별로 들고 있어야 함 (스키마는 그대로, 필드만 생략)
+                    //  - FlatBuffers 는 비운 필드를 아예 안 씀 -> Move 프레임이 문자열만큼 작아짐
+                    flatbuffers::Offset<flatbuffers::String> prefabStr = 0;
+                    if (!prefabOnEnterOnly_ || cmdType == field::FieldCmdType::FieldCmdType_Enter) {
+                        prefabStr = fbb.CreateString(prefab_or_default(get_prefab_id(ev.subjectId, isMonster)));
+                    }
+
+                    // FieldCmd.dir (클라 계약)
+                    //  - 기본: 비워 둠 (기존과 같음)
+                    //  - dead_reckoning: Enter/Move 의 dir 은 속도(m/s). 클라는 다음 Move 까지 위치 + dir * 경과시간 으로 외삽,
+                    //    dir 이 비어 있으면 정지. 서버는 외삽 오차가 dr_error_m 안이면 Move 를 안 보냄
+                    flatbuffers::Offset<field::Vec2> vel = 0;
+                    if (velocityInDir_ && cmdType != field::FieldCmdType::FieldCmdType_Leave
+                        && (ev.velocity.x != 0.f || ev.velocity.y != 0.f)) {
+                        vel = field::CreateVec2(fbb, ev.velocity.x, ev.velocity.y);
+                    }
+
+                    auto cmd = field::CreateFieldCmd(
+                        fbb,
+                        cmdType,
+                        et,
+                        ev.subjectId,
+                        pos,
+                        vel,
+                        prefabStr
+                    );
+
+                    auto envOffset = field::CreateEnvelope(
+                        fbb,
+                        field::Packet::Packet_FieldCmd,
+                        cmd.Union()
+                    );
+
+                    fbb.Finish(envOffset);
+
+                    proto::Frame::write(frames,
+                        fbb.GetBufferPointer(),
+                        static_cast<std::uint32_t>(fbb.GetSize()));
+                }
+
+                sess->send_frames(std::move(frames));
             }
         );
+    }
 
-        if (fieldId == 1000) {
-            SpawnMonstersEvenGrid(1000);
+    // players_/몬스터는 틱 스레드 전용: push 된 메시지는 스레드 하나 거치지 않고 여기서 바로 꺼냄
+    void FieldWorker::drain_inbox()
+    {
+        take_pending(inbox_);
+        while (!inbox_.empty()) {
+            handle_message(inbox_.front());
+            inbox_.pop();
         }
-
-        //  AOI Ȱȭ
-        aoiSystem_->set_initialized(true);
     }
 
-
-
-
-    FieldWorker::~FieldWorker() = default;
-
-    void FieldWorker::handle_message(const NetMessage& msg)
+    void FieldWorker::handle_message(NetMessage& msg)
     {
         if (!aoiSystem_) return;
 
+        // 다른 리전으로 넘어간 플레이어의 늦게 온 입력은 지금 소유 리전으로
+        if (forward_to_owner(msg))
+            return;
+
         if (msg.type == MessageType::Custom)
         {
             const uint8_t* buf = msg.payload.data();
@@ -148,7 +230,7 @@ namespace core {
             {				
                 on_client_move_input(*cmd, msg.session);
             }
-            // Enter/Leave  ⼭  ߰ б
+            // Enter/Leave 를 여기서도 쓰면 추가 분기
 
             return;
         }
@@ -157,6 +239,16 @@ namespace core {
             handle_skill(msg);
             return;
         }
+        else if (msg.type == MessageType::SkillEnvelope)
+        {
+            handle_skill_envelope(msg);
+            return;
+        }
+        else if (msg.type == MessageType::Internal)
+        {
+            handle_internal(msg);
+            return;
+        }
     }
 
 
@@ -185,10 +277,10 @@ namespace core {
 
         auto& mv = it->second->move_state();
 
-        // Է ð ׻ worldTime_ 
+        // 입력 시간은 항상 worldTime_ 기준
         mv.lastInputTime = worldTime_;
 
-        //  Է : ٷ Idle εĳƮ
+        // 정지 입력인 경우: 바로 Idle 브로드캐스트
         if (len2 < 1e-4f) {
             if (mv.moving) {
                 mv.moving = false;
@@ -196,11 +288,17 @@ namespace core {
                 mv.speed = 0.f;
 
                 env_.broadcastPlayerState(cmd.entityId(), monster_ecs::PlayerState::Idle);
+
+                // 속도 0 을 알려야 클라 외삽이 멈춤
+                if (aoiSystem_) {
+                    const Vec2 p = it->second->pos();
+                    aoiSystem_->move_entity(cmd.entityId(), p.x, p.y);
+                }
             }
             return;
         }
 
-        //  Է ִ :  ̱ ϴ  Move εĳƮ
+        // 방향 입력 있는 경우: 새로 움직이기 시작하는 순간에만 Move 브로드캐스트
         float invLen = 1.0f / std::sqrt(len2);
         dx *= invLen;
         dy *= invLen;
@@ -217,50 +315,423 @@ namespace core {
 
 
 
+    // 서버 내부 명령 (FlatBuffers 파싱 없이 바로 처리)
+    void FieldWorker::handle_internal(NetMessage& msg)
+    {
+        if (auto* mv = std::get_if<CmdMovePlayer>(&msg.cmd)) {
+            auto it = players_.find(mv->playerId);
+            if (it == players_.end() || !it->second) {
+                // 다른 채널/리전으로 넘어간 플레이어면 그쪽으로 (보정/텔레포트가 사라지지 않게)
+                const FieldOwner owner = FieldManager::instance().player_owner(mv->playerId);
+                if (owner.channel == channel_ && owner.region == regionIndex_)
+                    return;
+                if (auto w = FieldManager::instance().get_region(fieldId_, owner.channel, owner.region))
+                    w->push(std::move(msg));
+                return;
+            }
+
+            it->second->set_pos(mv->x, mv->y);
+            if (aoiSystem_)
+                aoiSystem_->move_entity(mv->playerId, mv->x, mv->y);
+        }
+        else if (auto* gs = std::get_if<CmdGhostSync>(&msg.cmd)) {
+            apply_ghost_sync(*gs);
+        }
+        else if (auto* ho = std::get_if<CmdHandoffPlayer>(&msg.cmd)) {
+            accept_handoff(*ho);
+        }
+        else if (auto* en = std::get_if<CmdEnterPlayer>(&msg.cmd)) {
+            enter_player(en->player);
+        }
+        else if (auto* lv = std::get_if<CmdLeavePlayer>(&msg.cmd)) {
+            leave_player(lv->playerId);
+        }
+        else if (auto* sk = std::get_if<CmdGhostSkill>(&msg.cmd)) {
+            attack_monster(sk->attackerId, sk->targetId, static_cast<game::SkillType>(sk->skill));
+        }
+        else if (auto* ge = std::get_if<CmdGhostEvent>(&msg.cmd)) {
+            apply_ghost_event(*ge);
+        }
+    }
+
+    // --------------------------------------------------------------------
+    // 리전 경계
+    //  - 소유 리전만 엔티티를 시뮬레이션, 경계 ghost_margin 안은 인접 리전에 ghost 로 복제
+    //  - 인접 리전 watcher 는 ghost 를 일반 엔티티처럼 Enter/Move/Leave 로 받음
+    //  - 플레이어가 경계를 kHandoffSlack 넘게 나가면 소유권을 넘김 (몬스터는 스폰 리전 고정)
+    // --------------------------------------------------------------------
+    std::shared_ptr<FieldWorker> FieldWorker::peer(int region) const
+    {
+        if (region == regionIndex_)
+            return nullptr;
+        return FieldManager::instance().get_region(fieldId_, channel_, region);
+    }
+
+    bool FieldWorker::forward_to_owner(NetMessage& msg)
+    {
+        if (!msg.session || msg.type == MessageType::Internal)
+            return false;
+
+        const std::uint64_t pid = msg.session->player_id();
+        if (players_.count(pid))
+            return false;
+
+        const FieldOwner owner = FieldManager::instance().player_owner(pid);
+        if (owner.channel == channel_ && owner.region == regionIndex_)
+            return false;
+
+        if (auto w = FieldManager::instance().get_region(fieldId_, owner.channel, owner.region))
+            w->push(std::move(msg));
+        return true;
+    }
+
+    void FieldWorker::apply_ghost_sync(const CmdGhostSync& sync)
+    {
+        if (!aoiSystem_) return;
+
+        for (const auto& g : sync.updates) {
+            auto [it, inserted] = ghosts_.try_emplace(g.id);
+            if (inserted) {
+                it->second.isMonster = g.isMonster;
+                it->second.prefab = g.isMonster ? g.prefab : player_prefab_id();
+            }
+            it->second.owner = sync.fromRegion;     // 핸드오프된 플레이어는 소유 리전이 바뀜
+        }
+        for (auto id : sync.removes)
+            ghosts_.erase(id);
+
+        for (const auto& g : sync.updates)
+            aoiSystem_->add_or_move_ghost(g.id, g.isMonster, g.x, g.y, g.vx, g.vy);
+
+        // 이미 이 리전 소유가 된 엔티티(핸드오프 직후)는 지우지 않음
+        for (auto id : sync.removes) {
+            if (aoiSystem_->is_ghost(id))
+                aoiSystem_->remove_entity(id);
+        }
+    }
+
+    void FieldWorker::apply_ghost_event(const CmdGhostEvent& ev)
+    {
+        // ghost 는 이 리전 mirrors_ 에 없으므로 다시 전달되지는 않음
+        const field::EntityType et = ev.isMonster
+            ? field::EntityType::EntityType_Monster
+            : field::EntityType::EntityType_Player;
+
+        if (ev.kind == CmdGhostEvent::Kind::AiState)
+            broadcast_ai_state(ev.id, et, static_cast<field::AiStateType>(ev.state));
+        else
+            broadcast_stat_event(ev.id, et, ev.hp, ev.maxHp, ev.sp, ev.maxSp);
+    }
+
+    void FieldWorker::mirror_ghost_event(const CmdGhostEvent& ev)
+    {
+        if (!layout_.partitioned())
+            return;
+
+        for (int r = 0; r < static_cast<int>(mirrors_.size()); ++r) {
+            if (r == regionIndex_ || !mirrors_[r].count(ev.id))
+                continue;
+
+            auto dst = peer(r);
+            if (!dst) continue;
+
+            NetMessage msg;
+            msg.type = MessageType::Internal;
+            msg.cmd = ev;
+            dst->push(std::move(msg));
+        }
+    }
+
+    void FieldWorker::accept_handoff(const CmdHandoffPlayer& ho)
+    {
+        if (!ho.player) return;
+
+        const std::uint64_t pid = ho.player->id();
+        ghosts_.erase(pid);
+
+        // 이전 리전이 만들어 둔 ghost 들은 이제 여기서 갱신/정리
+        //  (NaN 이라 다음 sync 에서 범위 안이면 갱신, 밖이면 remove)
+        for (int r : ho.mirroredTo) {
+            if (r == regionIndex_ || r < 0 || r >= static_cast<int>(mirrors_.size())) continue;
+            MirrorState& ms = mirrors_[r][pid];
+            ms.lastPos = { std::numeric_limits<float>::quiet_NaN(), 0.0f };
+            ms.seenTick = 0;
+        }
+
+        const Vec2 p = ho.player->pos();
+        if (players_.emplace(pid, ho.player).second)
+            ++playerCount_;
+
+        // 클라가 이미 보던 것은 Snapshot 없이 이어받음
+        if (aoiSystem_)
+            aoiSystem_->adopt_player(pid, p.x, p.y, ho.visible);
+
+        FieldManager::instance().set_player_owner(pid, FieldOwner{ channel_, regionIndex_ });
+
+        event_stats().handoffsIn.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void FieldWorker::handoff_player(std::uint64_t playerId, int targetRegion)
+    {
+        auto it = players_.find(playerId);
+        if (it == players_.end())
+            return;
+
+        auto dst = peer(targetRegion);
+        if (!dst)
+            return;
+
+        CmdHandoffPlayer ho;
+        ho.player = it->second;
+
+        // 여기서는 ghost 로 남김 (이 리전 watcher 는 계속 봄, 갱신은 새 소유 리전이 보냄)
+        if (aoiSystem_)
+            aoiSystem_->demote_to_ghost(playerId, ho.visible);
+
+        ho.mirroredTo.push_back(regionIndex_);
+        for (int r = 0; r < static_cast<int>(mirrors_.size()); ++r) {
+            if (mirrors_[r].erase(playerId))
+                ho.mirroredTo.push_back(r);
+        }
+
+        GhostInfo& g = ghosts_[playerId];
+        g.isMonster = false;
+        g.prefab = player_prefab_id();
+
+        players_.erase(it);
+        --playerCount_;
+
+        NetMessage msg;
+        msg.type = MessageType::Internal;
+        msg.cmd = std::move(ho);
+        dst->push(std::move(msg));
+
+        // 이후 입력은 새 리전으로 (그 사이 여기로 온 건 forward_to_owner 가 넘김)
+        FieldManager::instance().set_player_owner(playerId, FieldOwner{ channel_, targetRegion });
+    }
+
+    void FieldWorker::sync_border()
+    {
+        if (!layout_.partitioned() || !aoiSystem_)
+            return;
+
+        ++syncTick_;
+
+        // 1) 경계를 충분히 넘은 플레이어 핸드오프
+        thread_local std::vector<std::pair<std::uint64_t, int>> leaving;
+        leaving.clear();
+        for (auto& [pid, player] : players_) {
+            if (!player) continue;
+            const Vec2 p = player->pos();
+            if (bounds_.outside_dist(p.x, p.y) <= kHandoffSlack) continue;
+
+            const int target = layout_.region_of(p.x, p.y);
+            if (target != regionIndex_)
+                leaving.emplace_back(pid, target);
+        }
+        for (auto& [pid, target] : leaving)
+            handoff_player(pid, target);
+
+        // 2) 소유 엔티티 중 경계 근처를 인접 리전별로 모음 (위치가 바뀐 것만)
+        std::vector<CmdGhostSync> out(mirrors_.size());
+        thread_local std::vector<AoiOwnedEntity> owned;
+        thread_local std::vector<int> targets;
+        aoiSystem_->collect_owned(owned);
+
+        for (const auto& e : owned) {
+            layout_.mirror_targets(regionIndex_, e.pos.x, e.pos.y, targets);
+            for (int r : targets) {
+                auto [it, inserted] = mirrors_[r].try_emplace(e.id);
+                MirrorState& ms = it->second;
+                ms.seenTick = syncTick_;
+                if (!inserted && ms.lastPos.x == e.pos.x && ms.lastPos.y == e.pos.y
+                    && ms.lastVel.x == e.vel.x && ms.lastVel.y == e.vel.y)
+                    continue;
+                ms.lastPos = { e.pos.x, e.pos.y };
+                ms.lastVel = { e.vel.x, e.vel.y };
+
+                GhostState g;
+                g.id = e.id;
+                g.x = e.pos.x;
+                g.y = e.pos.y;
+                g.vx = e.vel.x;
+                g.vy = e.vel.y;
+                g.isMonster = !e.isPlayer;
+                if (inserted && g.isMonster && monsterWorld_.prefabNameComp.has(e.id))
+                    g.prefab = monsterWorld_.prefabNameComp.get(e.id).id;
+                out[r].updates.push_back(std::move(g));
+            }
+        }
+
+        // 3) 이번 틱에 안 잡힌 ghost = 멀어졌거나 사라짐
+        for (std::size_t r = 0; r < mirrors_.size(); ++r) {
+            auto& m = mirrors_[r];
+            for (auto it = m.begin(); it != m.end();) {
+                if (it->second.seenTick != syncTick_) {
+                    out[r].removes.push_back(it->first);
+                    it = m.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        // 4) 리전별로 한 번씩 전송
+        for (std::size_t r = 0; r < out.size(); ++r) {
+            if (out[r].updates.empty() && out[r].removes.empty())
+                continue;
+
+            auto dst = peer(static_cast<int>(r));
+            if (!dst) continue;
+
+            out[r].fromRegion = regionIndex_;
+
+            NetMessage msg;
+            msg.type = MessageType::Internal;
+            msg.cmd = std::move(out[r]);
+            dst->push(std::move(msg));
+        }
+    }
+
     // --------------------------------------------------------------------
-    // ÷̾ /
+    // 플레이어 등록/제거
     // --------------------------------------------------------------------
+    //  - 게임 샤드 여러 개가 동시에 부르므로 여기서는 명령만 넣음 (players_ 는 틱 스레드 전용)
+    //  - 채널 부하 판단이 로그인 몰림 때 밀리지 않게 인원은 미리 잡아둠 (enter_player 에서 정산)
     void FieldWorker::add_player(Player::Ptr player)
     {
         if (!player) return;
 
-        const uint64_t pid = player->id();
-        players_[pid] = player;
+        ++playerCount_;
+        // 소유 등록도 바로: 입장 직후 입력/퇴장이 틱 처리 전에 와도 이 워커로 옴
+        //  (큐 순서상 CmdEnterPlayer 뒤라 enter_player 가 리전을 바꾸면 거기서 다시 넘김)
+        FieldManager::instance().set_player_owner(player->id(), FieldOwner{ channel_, regionIndex_ });
 
-        //  ġ (װ  ʱ ǥ )
-        Vec2 p = player->pos();   // ̹ (5,5)  õǾ  ״ 
+        NetMessage msg;
+        msg.type = MessageType::Internal;
+        msg.cmd = CmdEnterPlayer{ std::move(player) };
+        push(std::move(msg));
+    }
 
-        std::cout << "[FieldWorker] add_player id=" << pid
-            << " pos=" << p.x << "," << p.y << std::endl;
+    void FieldWorker::remove_player(std::uint64_t playerId)
+    {
+        NetMessage msg;
+        msg.type = MessageType::Internal;
+        msg.cmd = CmdLeavePlayer{ playerId };
+        push(std::move(msg));
+    }
 
-        // ʵ  ó + /εĳƮ
+    void FieldWorker::enter_player(const Player::Ptr& player)
+    {
+        if (!player) {
+            --playerCount_;
+            return;
+        }
+
+        // 분할 필드: 입장 좌표를 소유한 리전으로 (인원 예약도 그쪽으로 옮김)
+        if (layout_.partitioned()) {
+            const Vec2 p = player->pos();
+            const int r = layout_.region_of(p.x, p.y);
+            if (r != regionIndex_) {
+                if (auto w = peer(r)) {
+                    w->add_player(player);
+                    --playerCount_;
+                    return;
+                }
+            }
+        }
+
+        const uint64_t pid = player->id();
+        if (!players_.emplace(pid, player).second) {
+            players_[pid] = player;
+            --playerCount_;     // 이미 있던 플레이어: 예약분 반납
+        }
+        FieldManager::instance().set_player_owner(pid, FieldOwner{ channel_, regionIndex_ });
+        event_stats().enters.fetch_add(1, std::memory_order_relaxed);
+
+        // 필드 입장 처리 + 스냅샷/브로드캐스트
         on_player_enter_field(player);
     }
 
-    void FieldWorker::remove_player(std::uint64_t playerId)
+    void FieldWorker::leave_player(std::uint64_t playerId)
     {
+        // 다른 채널/리전 소유 플레이어면 그쪽에서 제거
+        if (!players_.count(playerId)) {
+            const FieldOwner owner = FieldManager::instance().player_owner(playerId);
+            if (owner.channel != channel_ || owner.region != regionIndex_) {
+                if (auto w = FieldManager::instance().get_region(fieldId_, owner.channel, owner.region)) {
+                    w->remove_player(playerId);
+                }
+                return;
+            }
+        }
+
         if (aoiSystem_) {
             aoiSystem_->remove_entity(playerId);
         }
-        players_.erase(playerId);
+        if (players_.erase(playerId))
+            --playerCount_;
+        FieldManager::instance().clear_player_owner(playerId, FieldOwner{ channel_, regionIndex_ });
     }
 
 
     // --------------------------------------------------------------------
-    // ƽ Ʈ:   ̵ + AOI ݿ
-    //  -  δ "  " 
+    // 틱 업데이트: 서버 권한 이동 + AOI 반영
+    //  - 이 경로는 "서버 내부 로직" 전용
     // --------------------------------------------------------------------
     void FieldWorker::update_world(float dt)
     {
         if (dt <= 0.0f) return;
 
         worldTime_ += dt;
+
+        // 메시지 스레드가 받아 둔 입력/스킬/내부 명령 (리전 핸드오프 포함)
+        drain_inbox();
+
+        // 휴면: 이 리전을 볼 수 있는 플레이어(소유 + 인접 리전 ghost)가 한동안 없으면
+        //  리스폰 타이머와 경계 복제만 드물게 돌림. 플레이어가 들어오면 다음 틱에 바로 깸
+        const bool observed = player_count() > 0 || (aoiSystem_ && aoiSystem_->ghost_players() > 0);
+        unobservedTime_ = observed ? 0.0f : unobservedTime_ + dt;
+        const bool hibernate = hibernateAfter_ > 0.0f && unobservedTime_ >= hibernateAfter_;
+        if (hibernate != hibernating_) {
+            hibernating_ = hibernate;
+            (hibernate ? event_stats().hibernates : event_stats().wakes).fetch_add(1, std::memory_order_relaxed);
+
+            if (hibernate) {
+                monsterWorld_.halt_all(env_);
+                monsterPaths_.clear();
+                hibernateAcc_ = 0.0f;
+            }
+            else {
+                playerAcc_ = 0.0f;
+                monsterAcc_ = 0.0f;
+            }
+        }
+        if (hibernating_) {
+            hibernateAcc_ += dt;
+            if (hibernateAcc_ >= HibernateStep) {
+                monsterWorld_.update_hibernated(hibernateAcc_, env_);
+                hibernateAcc_ = 0.0f;
+                sync_border();
+                flush_aoi_events();
+            }
+            return;
+        }
+
+        // 지난 틱 이후 끝난 경로 탐색 결과 받기
+        if (pathfinder_) {
+            pathfinder_->begin_tick();
+        }
+        if (flowFields_) {
+            flowFields_->begin_tick();
+        }
         /*      std::cout << "[FW] field=" << fieldId_
                   << " monsters=" << monsterWorld_.monsters.size()
                   << " world_ptr=" << (void*)&monsterWorld_
                   << "\n";*/
                   // ----------------------------
-                  // ÷̾  ƽ (20Hz)
+                  // 플레이어 고정 틱 (20Hz)
                   // ----------------------------
         int playerLoops = 0;
         playerAcc_ += dt;
@@ -272,7 +743,7 @@ namespace core {
         }
 
         // ----------------------------
-        //   ƽ (10Hz)
+        // 몬스터 고정 틱 (10Hz)
         // ----------------------------
         int monsterLoops = 0;
         monsterAcc_ += dt;
@@ -282,16 +753,109 @@ namespace core {
             monsterAcc_ -= MonsterStep;
             monsterLoops++;
         }
+
+        // ----------------------------
+        // 리전 경계: ghost 복제 + 핸드오프 (분할 필드만)
+        // ----------------------------
+        sync_border();
+
+        // ----------------------------
+        // 이번 틱 AOI 이벤트 일괄 전송 (입력 이동으로 쌓인 것 포함)
+        // ----------------------------
+        flush_aoi_events();
     }
 
     // --------------------------------------------------------------------
-    // /浹 üũ ( )
+    // 맵/충돌 체크 (CollisionMap 비트맵, 맵이 없으면 전부 이동 가능)
     // --------------------------------------------------------------------
     bool FieldWorker::is_walkable(const Vec2& from, const Vec2& to) const
     {
-        (void)from;
-        (void)to;
-        // TODO:  , Ÿ, ̸  ؼ  浹 ˻縦 
+        if (!collision_)
+            return true;
+        return collision_->segment_clear(from.x, from.y, to.x, to.y);
+    }
+
+    bool FieldWorker::resolve_move(const Vec2& from, Vec2& to) const
+    {
+        if (is_walkable(from, to))
+            return true;
+
+        // 벽에 비스듬히 부딪히면 막히지 않은 축으로 미끄러짐
+        const Vec2 alongX{ to.x, from.y };
+        if (alongX.x != from.x && is_walkable(from, alongX)) {
+            to = alongX;
+            return true;
+        }
+        const Vec2 alongY{ from.x, to.y };
+        if (alongY.y != from.y && is_walkable(from, alongY)) {
+            to = alongY;
+            return true;
+        }
+        return false;
+    }
+
+    bool FieldWorker::steer_to(std::uint64_t monsterId, std::uint64_t targetId, const Vec2& from, Vec2& goal)
+    {
+        // 보이면 직선 추적 (대부분 여기서 끝)
+        if (!pathfinder_ || is_walkable(from, goal)) {
+            monsterPaths_.erase(monsterId);
+            return true;
+        }
+
+        // 같은 목표를 여럿이 쫓으면 공유 흐름장 (개별 경로 안 구함)
+        if (flowFields_) {
+            flowFields_->note_chaser(targetId, goal.x, goal.y);
+
+            Vec2 wp;
+            if (flowFields_->sample(targetId, from.x, from.y, wp.x, wp.y)) {
+                monsterPaths_.erase(monsterId);
+                goal = wp;
+                return true;
+            }
+        }
+
+        auto dist2 = [](const Vec2& a, const Vec2& b) {
+            const float dx = a.x - b.x;
+            const float dy = a.y - b.y;
+            return dx * dx + dy * dy;
+        };
+
+        auto it = monsterPaths_.find(monsterId);
+        if (it != monsterPaths_.end() && dist2(it->second.goal, goal) > repathDist_ * repathDist_) {
+            monsterPaths_.erase(it);    // 목표가 많이 움직였음 -> 다시 탐색
+            it = monsterPaths_.end();
+        }
+
+        if (it == monsterPaths_.end()) {
+            PathPtr path;
+            if (!pathfinder_->find(monsterId, PathPoint{ from.x, from.y }, PathPoint{ goal.x, goal.y }, path))
+                return false;
+            if (!path || path->empty())
+                return true;            // 길 없음: 직선으로 밀어보고 벽 따라 미끄러지기만
+            it = monsterPaths_.emplace(monsterId, MonsterPath{ std::move(path), 0, goal }).first;
+        }
+
+        MonsterPath& mp = it->second;
+        const PathPoints& pts = *mp.path;
+
+        // 다음 웨이포인트 도착 / 그 다음이 보이면 건너뜀 (점프 포인트 사이를 곧게 펴기)
+        constexpr float kArrive = 0.3f;
+        while (mp.next < pts.size()) {
+            const Vec2 wp{ pts[mp.next].x, pts[mp.next].y };
+            const bool arrived = dist2(from, wp) < kArrive * kArrive;
+            const bool skip = mp.next + 1 < pts.size()
+                && is_walkable(from, Vec2{ pts[mp.next + 1].x, pts[mp.next + 1].y });
+            if (!arrived && !skip)
+                break;
+            ++mp.next;
+        }
+
+        if (mp.next >= pts.size()) {
+            monsterPaths_.erase(it);    // 경로 끝 (다음 틱에 직선/재탐색)
+            return true;
+        }
+
+        goal = Vec2{ pts[mp.next].x, pts[mp.next].y };
         return true;
     }
 
@@ -301,7 +865,7 @@ namespace core {
         auto sess = net::SessionManager::instance().find_by_player_id(targetId);
         if (!sess) return;
 
-        flatbuffers::FlatBufferBuilder fbb;
+        auto& fbb = FbArena::builder();
 
         auto evOffset = field::CreateCombatEvent(
             fbb,
@@ -331,7 +895,7 @@ namespace core {
         auto sess = net::SessionManager::instance().find_by_player_id(watcherId);
         if (!sess) return;
 
-        flatbuffers::FlatBufferBuilder fbb;
+        auto& fbb = FbArena::builder();
 
         field::EntityType et = isMonster
             ? field::EntityType::EntityType_Monster
@@ -364,7 +928,7 @@ namespace core {
     void FieldWorker::monster_spawn_in_aoi(std::uint64_t monsterId, float x, float y)
     {
         if (aoiSystem_) {
-            // Ͷ isPlayer = false
+            // 몬스터라서 isPlayer = false
             aoiSystem_->add_entity(monsterId, /*isPlayer=*/false, x, y);
         }
     }
@@ -380,8 +944,6 @@ namespace core {
         auto session = msg.session;
         if (!session) return;
 
-        uint64_t pid = session->player_id();
-
         flatbuffers::Verifier verifier(
             reinterpret_cast<const uint8_t*>(msg.payload.data()),
             msg.payload.size());
@@ -397,152 +959,146 @@ namespace core {
             return;
         }
 
-        auto skillType = skill->skill();
-        uint64_t targetId = skill->targetId();
+        apply_skill(session->player_id(), *skill, msg.recvTime);
+    }
 
-        std::cout << "[SKILL] Player " << pid
-            << " attacked target=" << targetId
-            << " skill=" << static_cast<int>(skill->skill())
-            << std::endl;
+    // Session::on_read 에서 바로 넘어온 SkillCmd Envelope
+    //  - 검증은 I/O 스레드(IsSkillEnvelope)에서 이미 끝남
+    void FieldWorker::handle_skill_envelope(const NetMessage& msg)
+    {
+        auto session = msg.session;
+        if (!session) return;
 
-		env_.broadcastPlayerState(pid, monster_ecs::PlayerState::Attack);
-        // ??  //AOI ó MonsterWorld ο
-        bool dead = monsterWorld_.player_attack_monster(pid, targetId, skillType, env_);
+        auto* env = proto::get_envelope(msg.payload.data());
+        if (!env) return;
 
-        if (dead)
-        {
-			env_.broadcastAiState(targetId, monster_ecs::CAI::State::Dead);
-            std::cout << "[Monster] Dead id=" << targetId << std::endl;
+        auto* skill = env->pkt_as_SkillCmd();
+        if (!skill) {
+            std::cout << "[WARN] SkillCmd null" << std::endl;
+            return;
         }
+
+        apply_skill(session->player_id(), *skill, msg.recvTime);
     }
 
-    std::string FieldWorker::get_prefab_name(uint64_t id, bool isMonster)
+    FieldWorker::SkillLatencyStats& FieldWorker::skill_latency()
     {
-        if (isMonster)
-        {
+        static SkillLatencyStats st;
+        return st;
+    }
 
-            if (monsterWorld_.prefabNameComp.has(id))
-                return monsterWorld_.prefabNameComp.get(id).name;
+    FieldWorker::EventStats& FieldWorker::event_stats()
+    {
+        static EventStats st;
+        return st;
+    }
 
-            return "";  //  ã  ڿ
-        }
+    void FieldWorker::SkillLatencyStats::record(std::uint64_t us)
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+        sumUs.fetch_add(us, std::memory_order_relaxed);
 
-        // ÷̾
-        auto pit = players_.find(id);
-        if (pit != players_.end())
-            return "Paladin";   // ÷̾  Paladin 
+        std::uint64_t prev = maxUs.load(std::memory_order_relaxed);
+        while (us > prev && !maxUs.compare_exchange_weak(prev, us, std::memory_order_relaxed)) {
+        }
 
-        return "";
+        int b = 0;
+        while (b < kBuckets - 1 && us >= kBucketUpperUs[b])
+            ++b;
+        buckets[b].fetch_add(1, std::memory_order_relaxed);
     }
 
-    //   ӽ̽ core , FieldWorker ޼ ó ߰
-    void FieldWorker::send_field_enter(std::uint64_t watcherId, std::uint64_t subjectId, bool isMonster, const Vec2& pos)
+    void FieldWorker::apply_skill(uint64_t pid, const game::SkillCmd& skill,
+        std::chrono::steady_clock::time_point recvTime)
     {
-        auto sess = net::SessionManager::instance().find_by_player_id(watcherId);
-        if (!sess) return;
-
-        flatbuffers::FlatBufferBuilder fbb;
+        auto skillType = skill.skill();
+        uint64_t targetId = skill.targetId();
+
+        // 수신 -> 필드 처리까지 걸린 시간 (CombatEvent 직전). 로그 대신 카운터에만
+        if (recvTime.time_since_epoch().count() != 0) {
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - recvTime).count();
+            skill_latency().record(us > 0 ? static_cast<std::uint64_t>(us) : 0);
+        }
 
-        auto posOffset = field::CreateVec2(fbb, pos.x, pos.y);
+		env_.broadcastPlayerState(pid, monster_ecs::PlayerState::Attack);
+        // 공격 대상은 가시 상한에 밀리지 않게
+        aoiSystem_->set_focus(pid, targetId);
+
+        // 인접 리전 소유 몬스터(ghost): 소유 리전이 처리 (결과 브로드캐스트는 ghost 이벤트로 돌아옴)
+        auto git = ghosts_.find(targetId);
+        if (git != ghosts_.end() && git->second.isMonster) {
+            if (auto dst = peer(git->second.owner)) {
+                NetMessage msg;
+                msg.type = MessageType::Internal;
+                msg.cmd = CmdGhostSkill{ pid, targetId, static_cast<int>(skillType) };
+                dst->push(std::move(msg));
+            }
+            return;
+        }
 
-        field::EntityType et = isMonster
-            ? field::EntityType::EntityType_Monster
-            : field::EntityType::EntityType_Player;
+        attack_monster(pid, targetId, skillType);
+    }
 
-        std::string prefabName = get_prefab_name(subjectId, isMonster);
-        auto prefabStr = fbb.CreateString(prefabName);
+    void FieldWorker::attack_monster(uint64_t pid, uint64_t targetId, game::SkillType skillType)
+    {
+        // ?? 모든 계산/브로드/AOI 처리는 MonsterWorld 내부에서
+        bool dead = monsterWorld_.player_attack_monster(pid, targetId, skillType, env_);
 
-        auto cmd = field::CreateFieldCmd(
-            fbb,
-            field::FieldCmdType::FieldCmdType_Enter,
-            et,
-            subjectId,
-            posOffset,
-            0,
-            prefabStr
-        );
+        if (dead)
+        {
+			env_.broadcastAiState(targetId, monster_ecs::CAI::State::Dead);
+            // 공격자가 인접 리전 소유면 여기엔 없으니 무시됨 (그쪽 focus 는 다음 공격 때 바뀜)
+            aoiSystem_->set_focus(pid, 0);
+            std::cout << "[Monster] Dead id=" << targetId << std::endl;
+        }
+    }
 
-        auto envOffset = field::CreateEnvelope(
-            fbb,
-            field::Packet::Packet_FieldCmd,
-            cmd.Union()
-        );
+    NameId FieldWorker::get_prefab_id(uint64_t id, bool isMonster)
+    {
+        if (isMonster)
+        {
+            if (monsterWorld_.prefabNameComp.has(id))
+                return monsterWorld_.prefabNameComp.get(id).id;
+        }
+        else
+        {
+            // 플레이어라면
+            auto pit = players_.find(id);
+            if (pit != players_.end())
+                return player_prefab_id();
+        }
 
-        fbb.Finish(envOffset);
+        // 인접 리전 소유 (ghost)
+        auto git = ghosts_.find(id);
+        if (git != ghosts_.end())
+            return git->second.prefab;
 
-        sess->send_payload(
-            fbb.GetBufferPointer(),
-            static_cast<std::uint32_t>(fbb.GetSize())
-        );
+        return kNoName;
     }
 
-    // FieldWorker  ߰
+    // FieldWorker 멤버로 추가
     void FieldWorker::on_player_enter_field(Player::Ptr player)
     {
         if (!player) return;
 
         const uint64_t pid = player->id();
-        Vec2 p = player->pos();   // : {5,5}
+        Vec2 p = player->pos();   // 예: {5,5}
 
-        // 1) AOI  ( Move ̺Ʈ AOI ؼ )
+        // AOI 에 등록하면 전부 이번 틱 flush 로 나감 (필드 전체가 아니라 시야 안만)
+        //  - 본인: 자기 Enter + 반경 안 엔티티 Snapshot -> watcher 묶음이라 send 1회
+        //  - 주변 플레이어: 반경 안 watcher 에게만 Enter
         if (aoiSystem_) {
             aoiSystem_->add_entity(pid, /*isPlayer=*/true, p.x, p.y);
         }
-
-        // 2)  ÷̾ " +  ƼƼ"  
-        // 2-1) ڱ ڽ
-        send_field_enter(pid, pid, /*isMonster=*/false, p);
-
-        // 2-2)  ÷̾
-        for (auto& [otherId, other] : players_) {
-            if (otherId == pid) continue;
-            if (!other) continue;
-
-            Vec2 op = other->pos();
-            //   ÷̾ ,  ֵ Enter   
-            send_field_enter(pid, otherId, /*isMonster=*/false, op);
-        }
-
-        // 2-3)  ͵
-        for (auto mId : monsterWorld_.monsters) {
-            //  ECS  ° ġ  κи 
-            auto& tr = monsterWorld_.transform.get(mId);
-            Vec2 mp{ tr.x, tr.y };
-
-            send_field_enter(pid, mId, /*isMonster=*/true, mp);
-        }
-
-        // 3)  ÷̾鿡   ֡ Enter  ˷ֱ
-        for (auto& [otherId, other] : players_) {
-            if (otherId == pid) continue;
-            if (!other) continue;
-
-            send_field_enter(otherId, pid, /*isMonster=*/false, p);
-        }
-
-        //   α
-        std::cout << "[FieldWorker] on_player_enter_field pid="
-            << pid << " pos=" << p.x << "," << p.y << std::endl;
     }
     // FieldWorker.cpp
     void FieldWorker::init_monster_env()
     {
+        // 전체 players_ 순회 대신 AOI 그리드에서 반경 안 섹터만 조회
         env_.findClosestPlayer = [this](float x, float y, float maxDist) -> uint64_t {
-            uint64_t closestId = 0;
-            float closestDistSq = maxDist * maxDist;
-
-            for (auto& [pid, player] : players_) {
-                if (!player) continue;
-                Vec2 pos = player->pos();
-                float dx = pos.x - x;
-                float dy = pos.y - y;
-                float distSq = dx * dx + dy * dy;
-                if (distSq < closestDistSq) {
-                    closestDistSq = distSq;
-                    closestId = pid;
-                }
-            }
-            return closestId;
+            if (!aoiSystem_) return 0;
+            return aoiSystem_->find_nearest_player(x, y, maxDist);
             };
 
         env_.getPlayerPosition = [this](uint64_t pid, float& outX, float& outY) -> bool {
@@ -567,8 +1123,21 @@ namespace core {
                 );
             };
 
-        env_.moveInAoi = [this](uint64_t mid, float x, float y) {
-            if (aoiSystem_) aoiSystem_->move_entity(mid, x, y);
+        env_.moveInAoi = [this](uint64_t mid, float x, float y, float vx, float vy) {
+            if (aoiSystem_) aoiSystem_->move_entity(mid, x, y, vx, vy);
+            };
+
+        env_.resolveMove = [this](float fromX, float fromY, float& toX, float& toY) {
+            Vec2 to{ toX, toY };
+            if (!resolve_move(Vec2{ fromX, fromY }, to))
+                return false;
+            toX = to.x;
+            toY = to.y;
+            return true;
+            };
+
+        env_.isObserved = [this](float x, float y) -> bool {
+            return observed_.test(AoiVec2{ x, y });
             };
 
         env_.spawnInAoi = [this](uint64_t mid, float x, float y) {
@@ -579,6 +1148,17 @@ namespace core {
 
         env_.removeFromAoi = [this](uint64_t mid) {
             if (aoiSystem_) aoiSystem_->remove_entity(mid);
+            monsterPaths_.erase(mid);
+            if (pathfinder_) pathfinder_->cancel(mid);
+            };
+
+        env_.steerTarget = [this](uint64_t mid, uint64_t targetId, float x, float y, float& goalX, float& goalY) {
+            Vec2 goal{ goalX, goalY };
+            if (!steer_to(mid, targetId, Vec2{ x, y }, goal))
+                return false;
+            goalX = goal.x;
+            goalY = goal.y;
+            return true;
             };
 
         env_.broadcastAiState = [this](uint64_t monsterId, monster_ecs::CAI::State newState) {
@@ -636,6 +1216,10 @@ namespace core {
                 mv.dir = { 0.f, 0.f };
                 mv.speed = 0.f;
                 env_.broadcastPlayerState(pid, monster_ecs::PlayerState::Idle);
+                if (aoiSystem_) {
+                    const Vec2 p = player->pos();
+                    aoiSystem_->move_entity(pid, p.x, p.y);    // 속도 0 -> 클라 외삽 정지
+                }
                 continue;
             }
 
@@ -647,19 +1231,28 @@ namespace core {
             newPos.x += mv.dir.x * mv.speed * step;
             newPos.y += mv.dir.y * mv.speed * step;
 
-            if (!is_walkable(oldPos, newPos)) {
+            if (!resolve_move(oldPos, newPos)) {
+                // 막혀서 제자리: 클라가 계속 외삽하지 않도록 속도 0
+                if (aoiSystem_) {
+                    aoiSystem_->move_entity(pid, oldPos.x, oldPos.y);
+                }
                 continue;
             }
 
             player->set_pos(newPos.x, newPos.y);
 
+            // 벽에 미끄러진 경우도 있으니 실제 이동량으로 속도 계산
             if (aoiSystem_) {
-                aoiSystem_->move_entity(pid, newPos.x, newPos.y);
+                aoiSystem_->move_entity(pid, newPos.x, newPos.y,
+                    (newPos.x - oldPos.x) / step, (newPos.y - oldPos.y) / step);
             }
         }
     }
     void FieldWorker::tick_monsters(float step)
     {
+        // 관찰 섹터는 스텝마다 한 번만 (몬스터마다 AOI 락을 잡지 않도록)
+        if (env_.isObserved && aoiSystem_)
+            aoiSystem_->collect_observed(observed_);
         monsterWorld_.update(step, env_);
     }
     void FieldWorker::SpawnMonstersEvenGrid(int fieldId)
@@ -667,8 +1260,8 @@ namespace core {
         if (fieldId != 1000) return;
 
         constexpr int kSpawnCount = 300;
-        constexpr float kMinX = 0.f, kMaxX = 500.f;
-        constexpr float kMinY = 0.f, kMaxY = 500.f;
+        constexpr float kMinX = 0.f, kMaxX = kFieldWidth;
+        constexpr float kMinY = 0.f, kMaxY = kFieldHeight;
 
         constexpr int cols = 10;
         constexpr int rows = 10;
@@ -687,6 +1280,13 @@ namespace core {
             x = clampf(x, kMinX, kMaxX);
             y = clampf(y, kMinY, kMaxY);
 
+            // 분할 필드면 자기 리전 칸만 (몬스터는 스폰한 리전이 계속 소유)
+            if (layout_.region_of(x, y) != regionIndex_)
+                continue;
+            // 벽/장애물 위는 건너뜀
+            if (collision_ && collision_->blocked(x, y))
+                continue;
+
             const MonsterTemplate& tpl = kMonsterTemplates[i % kMonsterTemplates.size()];
 
             const int typeIndex = i % kMonsterTemplates.size();
@@ -722,32 +1322,40 @@ namespace core {
 
     void FieldWorker::broadcast_ai_state(uint64_t entityId, field::EntityType et, field::AiStateType fbState)
     {
-        aoiSystem_->for_each_watcher(entityId, [&](uint64_t watcherId) {
-            auto sess = net::SessionManager::instance().find_by_player_id(watcherId);
-            if (!sess) return;
+        // 내용이 watcher 와 무관하므로 한 번만 빌드
+        auto& fbb = FbArena::builder();
 
-            flatbuffers::FlatBufferBuilder fbb;
+        auto evOffset = field::CreateAiStateEvent(
+            fbb,
+            et,
+            entityId,
+            fbState
+        );
 
-            auto evOffset = field::CreateAiStateEvent(
-                fbb,
-                et,
-                entityId,
-                fbState
-            );
+        auto envOffset = field::CreateEnvelope(
+            fbb,
+            field::Packet::Packet_AiStateEvent,
+            evOffset.Union()
+        );
 
-            auto envOffset = field::CreateEnvelope(
-                fbb,
-                field::Packet::Packet_AiStateEvent,
-                evOffset.Union()
-            );
+        fbb.Finish(envOffset);
 
-            fbb.Finish(envOffset);
+        aoiSystem_->for_each_watcher(entityId, [&](uint64_t watcherId) {
+            auto sess = net::SessionManager::instance().find_by_player_id(watcherId);
+            if (!sess) return;
 
             sess->send_payload(
                 fbb.GetBufferPointer(),
                 static_cast<std::uint32_t>(fbb.GetSize())
             );
             });
+
+        CmdGhostEvent ev;
+        ev.kind = CmdGhostEvent::Kind::AiState;
+        ev.id = entityId;
+        ev.isMonster = (et == field::EntityType::EntityType_Monster);
+        ev.state = static_cast<std::uint8_t>(fbState);
+        mirror_ghost_event(ev);
     }
 
     void FieldWorker::broadcast_monster_ai_state(uint64_t monsterId, monster_ecs::CAI::State newState)
@@ -773,36 +1381,46 @@ namespace core {
     }
     void FieldWorker::broadcast_stat_event(uint64_t entityId, field::EntityType et, int hp, int maxHp, int sp, int maxSp)
     {
-        aoiSystem_->for_each_watcher(entityId, [&](uint64_t watcherId)
-            {
-                auto sess = net::SessionManager::instance().find_by_player_id(watcherId);
-                if (!sess) return;
+        auto& fbb = FbArena::builder();
 
-                flatbuffers::FlatBufferBuilder fbb;
+        auto evOffset = field::CreateStatEvent(
+            fbb,
+            et,
+            entityId,
+            hp,
+            maxHp,
+            sp,
+            maxSp
+        );
 
-                auto evOffset = field::CreateStatEvent(
-                    fbb,
-                    et,
-                    entityId,
-                    hp,
-                    maxHp,
-                    sp,
-                    maxSp
-                );
+        auto envOffset = field::CreateEnvelope(
+            fbb,
+            field::Packet::Packet_StatEvent,
+            evOffset.Union()
+        );
 
-                auto envOffset = field::CreateEnvelope(
-                    fbb,
-                    field::Packet::Packet_StatEvent,
-                    evOffset.Union()
-                );
+        fbb.Finish(envOffset);
 
-                fbb.Finish(envOffset);
+        aoiSystem_->for_each_watcher(entityId, [&](uint64_t watcherId)
+            {
+                auto sess = net::SessionManager::instance().find_by_player_id(watcherId);
+                if (!sess) return;
 
                 sess->send_payload(
                     fbb.GetBufferPointer(),
                     static_cast<std::uint32_t>(fbb.GetSize())
                 );
             });
+
+        CmdGhostEvent ev;
+        ev.kind = CmdGhostEvent::Kind::Stat;
+        ev.id = entityId;
+        ev.isMonster = (et == field::EntityType::EntityType_Monster);
+        ev.hp = hp;
+        ev.maxHp = maxHp;
+        ev.sp = sp;
+        ev.maxSp = maxSp;
+        mirror_ghost_event(ev);
     }
     void FieldWorker::broadcast_monster_stat(uint64_t monsterId,int hp, int maxHp,int sp, int maxSp)
     {
@@ -823,18 +1441,30 @@ namespace core {
         );
     }
 
-    // 򰡿 ִ ۵
+    // 어딘가에 있는 헬퍼들
 
     std::shared_ptr<core::FieldWorker> GetFieldWorker(int fieldId)
     {
         return core::FieldManager::instance().get_field(fieldId);
     }
 
+    std::shared_ptr<core::FieldWorker> GetFieldWorker(int fieldId, std::uint64_t playerId)
+    {
+        return core::FieldManager::instance().get_player_field(fieldId, playerId);
+    }
+
+    std::shared_ptr<core::FieldWorker> EnterFieldWorker(int fieldId, Player::Ptr player)
+    {
+        return core::FieldManager::instance().enter_field(fieldId, std::move(player));
+    }
+
     bool SendToFieldWorker(int fieldId, core::NetMessage msg)
     {
-        auto worker = core::FieldManager::instance().get_field(fieldId);
+        auto worker = msg.session
+            ? core::FieldManager::instance().get_player_field(fieldId, msg.session->player_id())
+            : core::FieldManager::instance().get_field(fieldId);
         if (!worker) {
-            // ׿ α ϳ ־θ 
+            // 디버그용 로그 하나 넣어두면 좋음
 
             return false;
         }
@@ -846,38 +1476,14 @@ namespace core {
 
     void send_move_to_fieldworker(std::uint64_t playerId, int fieldId, float x, float y)
     {
-        flatbuffers::FlatBufferBuilder fbb;
-
-        auto pos = field::CreateVec2(fbb, x, y);
-
-        auto cmd = field::CreateFieldCmd(
-            fbb,
-            field::FieldCmdType::FieldCmdType_Move,   // type
-            field::EntityType::EntityType_Player,     // entityType
-            playerId,                                 // entityId
-            pos,                                      // pos
-            0,                                        // dir ( ǥ ̶ 0)
-            fbb.CreateString("")                      // prefab (Ⱦ)
-        );
-
-        // FieldCmd Envelope 
-        auto envOffset = field::CreateEnvelope(
-            fbb,
-            field::Packet::Packet_FieldCmd,           // union Ÿ
-            cmd.Union()
-        );
-
-        fbb.Finish(envOffset);
-
         NetMessage msg;
-        msg.type = MessageType::Custom;
-        msg.session = nullptr;                        // ο̴ϱ  
-        msg.payload.assign(
-            fbb.GetBufferPointer(),
-            fbb.GetBufferPointer() + fbb.GetSize()
-        );
+        msg.type = MessageType::Internal;
+        msg.session = nullptr;                        // 내부용이니까 세션 없음
+        msg.cmd = CmdMovePlayer{ playerId, x, y };
 
-        SendToFieldWorker(fieldId, std::move(msg));
+        // 세션이 없으므로 SendToFieldWorker(채널 0, 리전 0) 대신 소유 채널/리전으로 직접
+        if (auto worker = core::FieldManager::instance().get_player_field(fieldId, playerId))
+            worker->push(std::move(msg));
     }
 
 
@@ -1,13 +1,21 @@
 // FieldWorker.h
 #pragma once
 #include <unordered_map>
+#include <mutex>
 #include "worker/worker.h"
 #include "game/player.h"
 #include "proto/generated/field_generated.h"
+#include "proto/generated/game_generated.h"
 #include "net/session.h"
+#include "config/server_config.h"
 #include "monster/MonsterWorld.h"
 #include "monster/Components.h"
 #include "field/monster/MonsterEnvironment.h"
+#include "field/FieldRegion.h"
+#include "field/AoiWorld.h"
+#include "field/CollisionMap.h"
+#include "field/PathService.h"
+#include "field/FlowField.h"
 namespace core {
 
     class FieldAoiSystem;
@@ -23,7 +31,7 @@ namespace core {
         int def;
     };
 
-    //  ø 迭
+    // 정적 템플릿 배열
     static const std::vector<MonsterTemplate> kMonsterTemplates = {
         {"BowAndArrow1",   200, 200, 100, 100, 7, 3},
         {"BowAndArrow2",   200, 200, 100, 100, 7, 3},
@@ -41,28 +49,96 @@ namespace core {
     public:
         using Ptr = std::shared_ptr<FieldWorker>;
 
-        explicit FieldWorker(int fieldId);
+        explicit FieldWorker(int fieldId, const config::AoiConfig& aoiCfg = config::AoiConfig{},
+            const FieldRegionLayout& layout = FieldRegionLayout{}, int regionIndex = 0, int channel = 0,
+            CollisionMap::Ptr collision = nullptr,
+            const config::FieldPathConfig& pathCfg = config::FieldPathConfig{});
         ~FieldWorker();
 
-        void handle_message(const NetMessage& msg);
+        // 필드 크기 (AOI 섹터 배열 크기 / 스폰 범위 / 리전 분할 기준)
+        static constexpr float kFieldWidth = 500.0f;
+        static constexpr float kFieldHeight = 500.0f;
+        // 리전 경계를 이만큼 넘어가야 핸드오프 (경계에서 왔다갔다 방지)
+        static constexpr float kHandoffSlack = 2.0f;
+
+        int  region_index() const { return regionIndex_; }
+        int  region_count() const { return layout_.region_count(); }
+        int  channel() const { return channel_; }
+
+        // 스킬 수신(I/O 스레드) -> 필드 처리까지 지연. 전체 워커 합산, 모니터 스레드가 읽음
+        struct SkillLatencyStats {
+            static constexpr int kBuckets = 6;
+            // 버킷 상한 (us). 마지막 버킷은 그 이상 전부
+            static constexpr std::uint64_t kBucketUpperUs[kBuckets - 1] = { 1000, 5000, 20000, 50000, 100000 };
+
+            std::atomic<std::uint64_t> count{ 0 };
+            std::atomic<std::uint64_t> sumUs{ 0 };
+            std::atomic<std::uint64_t> maxUs{ 0 };
+            std::atomic<std::uint64_t> buckets[kBuckets]{};
+
+            void record(std::uint64_t us);
+        };
+        static SkillLatencyStats& skill_latency();
+
+        // 틱 스레드 이벤트 수 (로그 대신, 모니터 스레드가 읽음)
+        struct EventStats {
+            std::atomic<std::uint64_t> enters{ 0 };       // 필드 입장 반영
+            std::atomic<std::uint64_t> handoffsIn{ 0 };   // 인접 리전에서 넘어옴
+            std::atomic<std::uint64_t> hibernates{ 0 };
+            std::atomic<std::uint64_t> wakes{ 0 };
+        };
+        static EventStats& event_stats();
+
+        // 이 워커가 소유한 플레이어 수 (채널 부하 판단용, 다른 스레드에서 읽음)
+        int  player_count() const { return playerCount_.load(std::memory_order_relaxed); }
+
+        // 틱 스레드에서 호출 (FieldWorker 는 메시지 스레드가 없음. push 된 건 drain_inbox 가 꺼냄)
+        void handle_message(NetMessage& msg);
         static inline float clampf(float v, float lo, float hi) {
             return std::max(lo, std::min(v, hi));
         }
-        //  ƽ ȣ (dt:  )
+        // 서버 틱에서 호출 (dt: 초 단위)
         void update_world(float dt);
+        // 틱 끝에서 AOI 이벤트 일괄 전송
+        void flush_aoi_events();
         void tick_players(float step);
         void tick_monsters(float step);
-        // ÷̾ / (ʵ /  )
+        bool hibernating() const { return hibernating_; }
+        // 플레이어 등록/제거 (필드 입장/퇴장 시 사용)
+        //  - 아무 스레드에서나 불러도 됨. 내부 명령으로 넣고 실제 반영은 다음 틱
         void add_player(Player::Ptr player);
         void remove_player(std::uint64_t playerId);
         void init_monster_env(); 
         int field_id() const { return fieldId_; }
         void on_client_move_input(const field::FieldCmd& cmd, net::Session::Ptr session);
-        std::string get_prefab_name(uint64_t entityId, bool isMonster);
-        void send_field_enter(std::uint64_t watcherId, std::uint64_t subjectId, bool isMonster, const Vec2& pos);
+        // NameTable id (모르면 kNoName)
+        NameId get_prefab_id(uint64_t entityId, bool isMonster);
         void on_player_enter_field(Player::Ptr player);
     private:
+        // 틱 시작: 워커 큐에 쌓인 입력/내부 명령을 넘겨받아 처리
+        void drain_inbox();
+        // 리전 경계: 넘어온 플레이어 받기, 틱 끝에 ghost 복제 + 핸드오프
+        void accept_handoff(const CmdHandoffPlayer& ho);
+        // add_player/remove_player 의 틱 스레드 쪽
+        void enter_player(const Player::Ptr& player);
+        void leave_player(std::uint64_t playerId);
+        void sync_border();
+        void handoff_player(std::uint64_t playerId, int targetRegion);
+        void apply_ghost_sync(const CmdGhostSync& sync);
+        void apply_ghost_event(const CmdGhostEvent& ev);
+        // 경계 근처라 인접 리전에 복제 중인 엔티티의 이벤트를 그 리전들로 전달
+        void mirror_ghost_event(const CmdGhostEvent& ev);
+        bool forward_to_owner(NetMessage& msg);
+        // 같은 채널의 다른 리전 워커 (FieldManager 조회)
+        std::shared_ptr<FieldWorker> peer(int region) const;
+
         bool is_walkable(const Vec2& from, const Vec2& to) const;
+        // from -> to 가 막히면 벽을 따라 한 축만 이동 (to 를 고침). 아예 못 움직이면 false
+        bool resolve_move(const Vec2& from, Vec2& to) const;
+        // 몬스터 추적: goal 까지 막혀 있으면 다음 웨이포인트로 goal 을 바꿈
+        //  - 목표의 흐름장이 있으면 그걸 읽고, 없으면 개별 경로(JPS, 비동기)
+        //  - 경로가 아직 안 왔으면 false (제자리 대기), 길이 없으면 goal 그대로 (벽 미끄러짐)
+        bool steer_to(std::uint64_t monsterId, std::uint64_t targetId, const Vec2& from, Vec2& goal);
         void SpawnMonstersEvenGrid(int fieldId);
 
         void broadcast_ai_state(uint64_t entityId, field::EntityType et, field::AiStateType fbState);
@@ -74,30 +150,93 @@ namespace core {
         void broadcast_player_stat(uint64_t playerId, int hp, int maxHp, int sp, int maxSp);
     private:
         int fieldId_{ 0 };    
-        float worldTime_ = 0.0f;  // ʵ   ð()
+        float worldTime_ = 0.0f;  // 필드 기준 누적 시간(초)
         monster_ecs::MonsterWorld monsterWorld_;
         monster_ecs::MonsterEnvironment env_;
         std::shared_ptr<FieldAoiSystem> aoiSystem_;
-        // playerId -> Player
+        bool prefabOnEnterOnly_ = false;   // AoiConfig::prefab_on_enter_only (flush_aoi_events 인코딩)
+        bool velocityInDir_ = false;       // AoiConfig::dead_reckoning (dir 에 속도)
+        CollisionMap::Ptr collision_;   // 읽기 전용 공유 (없으면 어디든 이동 가능)
+
+        // 경로 탐색 (충돌 맵 있을 때만). 틱 스레드 전용
+        struct MonsterPath
+        {
+            PathPtr     path;
+            std::size_t next = 0;
+            Vec2        goal{};     // 이 경로를 구할 때의 목표 (repath 판단)
+        };
+        FieldPathfinder::Ptr                         pathfinder_;
+        FieldFlowFields::Ptr                         flowFields_;
+        float                                        repathDist_ = 2.0f;
+        std::unordered_map<std::uint64_t, MonsterPath> monsterPaths_;
+        // 몬스터 스텝 시작에 찍어 둔 관찰 섹터 (env_.isObserved 가 락 없이 조회)
+        AoiObservedMask                              observed_;
+        // playerId -> Player. 틱 스레드 전용 (입력도 drain_inbox 로 틱 스레드에서 처리)
         std::unordered_map<std::uint64_t, Player::Ptr> players_;
+
+        std::queue<NetMessage>  inbox_;     // 틱 스레드가 처리 중인 묶음 (take_pending 으로 swap)
         float playerAcc_ = 0.0f;
         float monsterAcc_ = 0.0f;
 
         static constexpr float PlayerStep = 0.05f;  // 50ms
         static constexpr float MonsterStep = 0.10f;  // 100ms
+
+        // 휴면: 관찰자가 hibernateAfter_ 초 동안 없으면 리스폰 타이머/경계 복제만 HibernateStep 마다
+        static constexpr float HibernateStep = 1.0f;
+        float hibernateAfter_ = 0.0f;
+        float unobservedTime_ = 0.0f;
+        float hibernateAcc_ = 0.0f;
+        bool  hibernating_ = false;
+
+        // ----- 리전 (한 필드를 여러 워커가 나눠 맡을 때) -----
+        FieldRegionLayout                       layout_;
+        int                                     regionIndex_ = 0;
+        int                                     channel_ = 0;     // 같은 필드의 인스턴스 번호
+        std::atomic<int>                        playerCount_{ 0 };
+        RegionRect                              bounds_{};
+
+        // 아래 경계 상태는 전부 틱 스레드 전용
+        // 인접 리전에 내보낸 ghost (리전 번호 -> id -> 마지막으로 보낸 위치)
+        struct MirrorState
+        {
+            Vec2          lastPos{};
+            Vec2          lastVel{};
+            std::uint32_t seenTick = 0;
+        };
+        std::vector<std::unordered_map<std::uint64_t, MirrorState>> mirrors_;
+        std::uint32_t syncTick_ = 0;
+
+        // 인접 리전에서 받은 ghost (프리팹 이름 조회용)
+        struct GhostInfo
+        {
+            bool        isMonster = false;
+            NameId      prefab = kNoName;
+            int         owner = 0;      // 소유 리전 (ghost 대상 스킬 전달용)
+        };
+        std::unordered_map<std::uint64_t, GhostInfo> ghosts_;
     private:        
         void send_combat_event(field::EntityType attackerType,uint64_t  attackerId, field::EntityType targetType, uint64_t targetId,int damage,int remainHp);
         void send_stat_event(std::uint64_t watcherId, std::uint64_t subjectId, bool isMonster, int hp, int maxHp, int sp, int maxSp);
         void monster_spawn_in_aoi(std::uint64_t monsterId, float x, float y);
         void monster_remove_from_aoi(std::uint64_t monsterId);
         void handle_skill(const NetMessage& msg);
+        void handle_internal(NetMessage& msg);
+        void handle_skill_envelope(const NetMessage& msg);
+        void apply_skill(uint64_t pid, const game::SkillCmd& skill,
+            std::chrono::steady_clock::time_point recvTime);
+        // 이 리전 소유 몬스터 공격 (직접 받은 스킬 + 인접 리전이 넘긴 스킬)
+        void attack_monster(uint64_t pid, uint64_t targetId, game::SkillType skillType);
     };
 
-    // WorkerManager      
+    // WorkerManager 관련 헬퍼    
     std::shared_ptr<core::FieldWorker> GetFieldWorker(int fieldId);
-    bool SendToFieldWorker(int fieldId, NetMessage msg);
+    // 분할 필드면 플레이어를 지금 소유한 리전 워커
+    std::shared_ptr<core::FieldWorker> GetFieldWorker(int fieldId, std::uint64_t playerId);
+    bool SendToFieldWorker(int fieldId, NetMessage msg);   // msg.session 의 플레이어 기준 리전
+    // 필드 입장: 채널 선택(필요하면 증설) + add_player. 입장 처리 쪽은 이걸 쓰면 됨
+    std::shared_ptr<core::FieldWorker> EnterFieldWorker(int fieldId, Player::Ptr player);
 
-    // (ɼ) Ŭ ǥ Move ʵĿ  
+    // (옵션) 클라 절대좌표 Move를 필드워커로 보내는 헬퍼
     void send_move_to_fieldworker(std::uint64_t playerId, int fieldId, float x, float y);
 
 } // namespace core
\ No newline at end of file
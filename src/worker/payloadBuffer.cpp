@@ -0,0 +1,97 @@
+#include "payloadBuffer.h"
+
+#include <new>
+
+namespace core {
+
+    PayloadSlabPool& PayloadSlabPool::local()
+    {
+        // 스레드가 먼저 끝나도 다른 스레드가 들고 있던 슬랩이 돌아올 수 있으므로
+        // 풀 자체는 해제하지 않음 (서버 스레드는 프로세스 수명과 같음)
+        thread_local PayloadSlabPool* pool = new PayloadSlabPool();
+        return *pool;
+    }
+
+    PayloadSlabPool::Stats& PayloadSlabPool::stats()
+    {
+        static Stats s;
+        return s;
+    }
+
+    PayloadSlabPool::Slab* PayloadSlabPool::acquire(std::size_t bytes)
+    {
+        auto& st = stats();
+        st.slabAcquires.fetch_add(1, std::memory_order_relaxed);
+
+        int cls = 0;
+        while (cls < kClassCount && kClassBytes[cls] < bytes)
+            ++cls;
+
+        // 풀 크기를 넘는 payload 는 그냥 힙에서 (드묾)
+        if (cls == kClassCount) {
+            st.heapAllocs.fetch_add(1, std::memory_order_relaxed);
+            void* mem = ::operator new(sizeof(Slab) + bytes);
+            auto* s = new (mem) Slab{};
+            s->capacity = static_cast<std::uint32_t>(bytes);
+            s->sizeClass = kNoClass;
+            return s;
+        }
+
+        PayloadSlabPool& pool = local();
+        if (!pool.free_[cls])
+            pool.drain_remote();
+
+        if (Slab* s = pool.free_[cls]) {
+            pool.free_[cls] = s->next;
+            s->next = nullptr;
+            return s;
+        }
+
+        st.heapAllocs.fetch_add(1, std::memory_order_relaxed);
+        void* mem = ::operator new(sizeof(Slab) + kClassBytes[cls]);
+        auto* s = new (mem) Slab{};
+        s->owner = &pool;
+        s->capacity = kClassBytes[cls];
+        s->sizeClass = static_cast<std::uint8_t>(cls);
+        return s;
+    }
+
+    void PayloadSlabPool::release(Slab* slab)
+    {
+        if (!slab) return;
+
+        if (slab->sizeClass == kNoClass) {
+            slab->~Slab();
+            ::operator delete(slab);
+            return;
+        }
+
+        PayloadSlabPool* owner = slab->owner;
+        if (owner == &local()) {
+            slab->next = owner->free_[slab->sizeClass];
+            owner->free_[slab->sizeClass] = slab;
+            return;
+        }
+
+        // 다른 스레드 소유: 소유 스레드 반납 스택에 push (MPSC)
+        stats().remoteReleases.fetch_add(1, std::memory_order_relaxed);
+        Slab* head = owner->remote_.load(std::memory_order_relaxed);
+        do {
+            slab->next = head;
+        } while (!owner->remote_.compare_exchange_weak(
+            head, slab, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // 소유 스레드에서만 호출: 반납 스택을 통째로 가져와 free list 로 옮김
+    void PayloadSlabPool::drain_remote()
+    {
+        Slab* s = remote_.exchange(nullptr, std::memory_order_acquire);
+        while (s) {
+            Slab* next = s->next;
+            s->next = free_[s->sizeClass];
+            free_[s->sizeClass] = s;
+            s = next;
+        }
+    }
+
+} // namespace core
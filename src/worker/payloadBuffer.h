@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace core {
+
+    // ====================================================================
+    // PayloadSlabPool
+    //  - 인라인 버퍼에 안 들어가는 payload 용 슬랩 풀 (스레드마다 하나)
+    //  - 다른 스레드에서 반납된 슬랩은 소유 스레드의 반납 스택으로 돌아감
+    //    (I/O 스레드 할당 -> 워커 스레드 해제 패턴에서 malloc 교차 해제 방지)
+    // ====================================================================
+    class PayloadSlabPool {
+    public:
+        struct Slab {
+            PayloadSlabPool* owner = nullptr;
+            Slab*            next = nullptr;
+            std::uint32_t    capacity = 0;   // 헤더 제외 바이트 수
+            std::uint8_t     sizeClass = 0;
+
+            std::uint8_t* bytes() { return reinterpret_cast<std::uint8_t*>(this + 1); }
+        };
+
+        struct Stats {
+            std::atomic<std::uint64_t> inlineAssigns{ 0 };  // 인라인으로 처리된 payload
+            std::atomic<std::uint64_t> slabAcquires{ 0 };   // 슬랩을 쓴 payload
+            std::atomic<std::uint64_t> heapAllocs{ 0 };     // 실제 new 호출 (슬랩 생성 + 초과 크기)
+            std::atomic<std::uint64_t> remoteReleases{ 0 }; // 다른 스레드에서 반납
+        };
+
+        // 현재 스레드의 풀 (스레드 종료 후에도 반납될 수 있어 해제하지 않음)
+        static PayloadSlabPool& local();
+
+        static Slab* acquire(std::size_t bytes);
+        static void  release(Slab* slab);
+
+        static Stats& stats();
+
+    private:
+        PayloadSlabPool() = default;
+
+        void drain_remote();
+
+        static constexpr int kClassCount = 4;
+        static constexpr std::uint32_t kClassBytes[kClassCount] = { 512, 2048, 8192, 65536 };
+        static constexpr std::uint8_t  kNoClass = 0xFF;
+
+        Slab*              free_[kClassCount] = {};
+        std::atomic<Slab*> remote_{ nullptr };
+    };
+
+    // ====================================================================
+    // PayloadBuffer
+    //  - NetMessage::payload 용 small-buffer 최적화 바이트 버퍼
+    //  - kInline 이하(대부분의 Move 입력 30~80B)는 힙 할당 없음
+    //  - std::vector<uint8_t> 에서 쓰던 assign/data/size 인터페이스 유지
+    // ====================================================================
+    class PayloadBuffer {
+    public:
+        static constexpr std::size_t kInline = 128;
+
+        PayloadBuffer() = default;
+        ~PayloadBuffer() { reset(); }
+
+        PayloadBuffer(const PayloadBuffer& o) { assign(o.data(), o.data() + o.size()); }
+        PayloadBuffer& operator=(const PayloadBuffer& o)
+        {
+            if (this != &o) assign(o.data(), o.data() + o.size());
+            return *this;
+        }
+
+        PayloadBuffer(PayloadBuffer&& o) noexcept { steal(o); }
+        PayloadBuffer& operator=(PayloadBuffer&& o) noexcept
+        {
+            if (this != &o) {
+                reset();
+                steal(o);
+            }
+            return *this;
+        }
+
+        void assign(const std::uint8_t* first, const std::uint8_t* last)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            resize_discard(n);
+            if (n) std::memcpy(data(), first, n);
+        }
+
+        template <typename It>
+        void assign(It first, It last)
+        {
+            if constexpr (std::is_pointer_v<It>) {
+                assign(reinterpret_cast<const std::uint8_t*>(first),
+                    reinterpret_cast<const std::uint8_t*>(last));
+            }
+            else {
+                const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                resize_discard(n);
+                std::uint8_t* out = data();
+                for (; first != last; ++first)
+                    *out++ = static_cast<std::uint8_t>(*first);
+            }
+        }
+
+        // 기존 내용은 보존하지 않음 (수신 프레임을 통째로 덮어쓰는 용도)
+        void resize(std::size_t n) { resize_discard(n); }
+        void clear() { reset(); }
+
+        std::uint8_t*       data()       { return slab_ ? slab_->bytes() : inline_; }
+        const std::uint8_t* data() const { return slab_ ? slab_->bytes() : inline_; }
+        std::size_t size() const { return size_; }
+        bool        empty() const { return size_ == 0; }
+
+        std::uint8_t*       begin()       { return data(); }
+        std::uint8_t*       end()         { return data() + size_; }
+        const std::uint8_t* begin() const { return data(); }
+        const std::uint8_t* end()   const { return data() + size_; }
+
+        std::uint8_t  operator[](std::size_t i) const { return data()[i]; }
+        std::uint8_t& operator[](std::size_t i)       { return data()[i]; }
+
+    private:
+        void resize_discard(std::size_t n)
+        {
+            if (n <= kInline) {
+                reset();
+                PayloadSlabPool::stats().inlineAssigns.fetch_add(1, std::memory_order_relaxed);
+            }
+            else if (!slab_ || slab_->capacity < n) {
+                reset();
+                slab_ = PayloadSlabPool::acquire(n);
+            }
+            size_ = n;
+        }
+
+        void reset()
+        {
+            if (slab_) {
+                PayloadSlabPool::release(slab_);
+                slab_ = nullptr;
+            }
+            size_ = 0;
+        }
+
+        void steal(PayloadBuffer& o) noexcept
+        {
+            size_ = o.size_;
+            slab_ = o.slab_;
+            if (!slab_ && size_)
+                std::memcpy(inline_, o.inline_, size_);
+            o.slab_ = nullptr;
+            o.size_ = 0;
+        }
+
+    private:
+        std::size_t            size_ = 0;
+        PayloadSlabPool::Slab* slab_ = nullptr;
+        std::uint8_t           inline_[kInline];
+    };
+
+} // namespace core
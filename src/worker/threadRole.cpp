@@ -0,0 +1,251 @@
+#include "threadRole.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+namespace core {
+
+    namespace {
+
+#ifdef _WIN32
+        using NativeHandle = HANDLE;
+
+        NativeHandle current_native() { return ::GetCurrentThread(); }
+
+        void set_name(NativeHandle h, const std::string& name)
+        {
+            std::wstring wname(name.begin(), name.end());
+            ::SetThreadDescription(h, wname.c_str());
+        }
+
+        // Windows 는 프로세서 그룹(64개) 단위라 첫 CPU 의 그룹만 사용
+        bool set_affinity(NativeHandle h, const std::vector<int>& cpus)
+        {
+            if (cpus.empty()) return false;
+
+            GROUP_AFFINITY ga{};
+            ga.Group = static_cast<WORD>(cpus.front() / 64);
+            for (int cpu : cpus) {
+                if (cpu / 64 != ga.Group) continue;
+                ga.Mask |= (KAFFINITY(1) << (cpu % 64));
+            }
+            return ::SetThreadGroupAffinity(h, &ga, nullptr) != 0;
+        }
+
+        int numa_node_of_cpu(int cpu)
+        {
+            PROCESSOR_NUMBER pn{};
+            pn.Group = static_cast<WORD>(cpu / 64);
+            pn.Number = static_cast<BYTE>(cpu % 64);
+
+            USHORT node = 0;
+            if (!::GetNumaProcessorNodeEx(&pn, &node))
+                return -1;
+            return static_cast<int>(node);
+        }
+#else
+        using NativeHandle = pthread_t;
+
+        NativeHandle current_native() { return ::pthread_self(); }
+
+        void set_name(NativeHandle h, const std::string& name)
+        {
+            // 리눅스는 15자 제한
+            ::pthread_setname_np(h, name.substr(0, 15).c_str());
+        }
+
+        bool set_affinity(NativeHandle h, const std::vector<int>& cpus)
+        {
+            if (cpus.empty()) return false;
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus) {
+                if (cpu >= 0 && cpu < CPU_SETSIZE)
+                    CPU_SET(cpu, &set);
+            }
+            return ::pthread_setaffinity_np(h, sizeof(set), &set) == 0;
+        }
+
+        int numa_node_of_cpu(int cpu)
+        {
+            // libnuma 없이 sysfs 로: /sys/devices/system/cpu/cpuN/nodeK
+            const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            DIR* dir = ::opendir(path.c_str());
+            if (!dir) return -1;
+
+            int node = -1;
+            while (dirent* e = ::readdir(dir)) {
+                if (std::strncmp(e->d_name, "node", 4) == 0 && e->d_name[4] >= '0' && e->d_name[4] <= '9') {
+                    node = std::atoi(e->d_name + 4);
+                    break;
+                }
+            }
+            ::closedir(dir);
+            return node;
+        }
+#endif
+
+        int role_index(ThreadRole role) { return static_cast<int>(role); }
+
+    } // namespace
+
+    const char* ThreadRoleName(ThreadRole role)
+    {
+        switch (role) {
+        case ThreadRole::Io:      return "io";
+        case ThreadRole::Game:    return "game";
+        case ThreadRole::Field:   return "field";
+        case ThreadRole::Tick:    return "tick";
+        case ThreadRole::Db:      return "db";
+        case ThreadRole::Monitor: return "monitor";
+        case ThreadRole::Path:    return "path";
+        default:                  return "unknown";
+        }
+    }
+
+    ThreadRoleRegistry& ThreadRoleRegistry::instance()
+    {
+        static ThreadRoleRegistry g;
+        return g;
+    }
+
+    void ThreadRoleRegistry::configure(const config::ThreadConfig& cfg)
+    {
+        pin_ = cfg.pin;
+        cpus_[role_index(ThreadRole::Io)] = cfg.io;
+        cpus_[role_index(ThreadRole::Game)] = cfg.game;
+        cpus_[role_index(ThreadRole::Field)] = cfg.field;
+        cpus_[role_index(ThreadRole::Tick)] = cfg.tick;
+        cpus_[role_index(ThreadRole::Db)] = cfg.db;
+        cpus_[role_index(ThreadRole::Monitor)] = cfg.monitor;
+        cpus_[role_index(ThreadRole::Path)] = cfg.path;
+
+        if (!pin_) return;
+
+        for (int r = 0; r < role_index(ThreadRole::Count); ++r) {
+            const auto role = static_cast<ThreadRole>(r);
+            std::cout << "[Thread] role=" << ThreadRoleName(role)
+                << " cpus=" << cpus_[r].size()
+                << " node=" << numa_node(role) << "\n";
+        }
+    }
+
+    void ThreadRoleRegistry::apply_current(ThreadRole role, const std::string& name)
+    {
+        set_name(current_native(), name);
+        if (pin_)
+            set_affinity(current_native(), cpus(role));
+    }
+
+    void ThreadRoleRegistry::apply(std::thread::native_handle_type handle, ThreadRole role, const std::string& name)
+    {
+        auto h = static_cast<NativeHandle>(handle);
+        set_name(h, name);
+        if (pin_)
+            set_affinity(h, cpus(role));
+    }
+
+    const std::vector<int>& ThreadRoleRegistry::cpus(ThreadRole role) const
+    {
+        return cpus_[role_index(role)];
+    }
+
+    int ThreadRoleRegistry::numa_node(ThreadRole role) const
+    {
+        const auto& c = cpus(role);
+        if (c.empty()) return -1;
+        return numa_node_of_cpu(c.front());
+    }
+
+    void ThreadRoleRegistry::set_tick_slots(int slots)
+    {
+        tickSlots_ = (slots > 0) ? slots : 1;
+    }
+
+    std::vector<int> ThreadRoleRegistry::tick_slot_cpus(int slot) const
+    {
+        const auto& c = cpus(ThreadRole::Tick);
+        if (c.empty() || slot < 0) return {};
+
+        // CPU 가 슬롯보다 적으면 슬롯끼리 CPU 하나를 나눠 씀
+        const std::size_t n = c.size();
+        const std::size_t s = static_cast<std::size_t>(tickSlots_);
+        const std::size_t i = static_cast<std::size_t>(slot) % s;
+        if (n < s)
+            return { c[i % n] };
+
+        // 연속 구간으로 잘라야 config 에서 노드별로 적어 둔 CPU 가 한 슬롯에 모임
+        return std::vector<int>(c.begin() + i * n / s, c.begin() + (i + 1) * n / s);
+    }
+
+    void ThreadRoleRegistry::apply_current_tick(int slot, const std::string& name)
+    {
+        set_name(current_native(), name);
+        if (pin_)
+            set_affinity(current_native(), tick_slot_cpus(slot));
+    }
+
+    // ================ ScopedThreadAffinity ================
+
+    ScopedThreadAffinity::ScopedThreadAffinity(ThreadRole role)
+        : ScopedThreadAffinity(ThreadRoleRegistry::instance().cpus(role))
+    {
+    }
+
+    ScopedThreadAffinity::ScopedThreadAffinity(const std::vector<int>& c)
+    {
+        auto& reg = ThreadRoleRegistry::instance();
+        if (!reg.pinned()) return;
+        if (c.empty()) return;
+
+#ifdef _WIN32
+        GROUP_AFFINITY old{};
+        if (!::GetThreadGroupAffinity(::GetCurrentThread(), &old))
+            return;
+        oldMask_.assign(1, static_cast<std::uint64_t>(old.Mask));
+        oldGroup_ = old.Group;
+#else
+        cpu_set_t old;
+        CPU_ZERO(&old);
+        if (::pthread_getaffinity_np(::pthread_self(), sizeof(old), &old) != 0)
+            return;
+        oldMask_.assign((CPU_SETSIZE + 63) / 64, 0);
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &old))
+                oldMask_[cpu / 64] |= (std::uint64_t(1) << (cpu % 64));
+        }
+#endif
+        applied_ = set_affinity(current_native(), c);
+    }
+
+    ScopedThreadAffinity::~ScopedThreadAffinity()
+    {
+        if (!applied_) return;
+
+#ifdef _WIN32
+        GROUP_AFFINITY ga{};
+        ga.Group = oldGroup_;
+        ga.Mask = static_cast<KAFFINITY>(oldMask_.front());
+        ::SetThreadGroupAffinity(::GetCurrentThread(), &ga, nullptr);
+#else
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (oldMask_[cpu / 64] & (std::uint64_t(1) << (cpu % 64)))
+                CPU_SET(cpu, &set);
+        }
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+#endif
+    }
+
+} // namespace core
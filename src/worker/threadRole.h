@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "config/server_config.h"
+
+namespace core {
+
+    // 서버 스레드 역할 (config.json "threads" 섹션과 1:1)
+    enum class ThreadRole : std::uint8_t {
+        Io = 0,      // libuv 루프 (메인 스레드)
+        Game,        // GameWorker 샤드
+        Field,       // 필드 밖 생성 작업용 (FieldWorker 는 자기 틱 슬롯 CPU 에서 생성, 틱 스레드가 큐를 비움)
+        Tick,        // TickWorkers (update_world)
+        Db,          // DBWorker
+        Monitor,     // 큐 모니터
+        Path,        // PathService (몬스터 경로 탐색)
+        Count
+    };
+
+    const char* ThreadRoleName(ThreadRole role);
+
+    // 스레드 이름 지정 + 역할별 CPU 셋 고정
+    //  - configure() 는 스레드 생성 전에 한 번만 호출
+    //  - pin=false 면 이름만 붙이고 affinity 는 건드리지 않음
+    class ThreadRoleRegistry {
+    public:
+        static ThreadRoleRegistry& instance();
+
+        void configure(const config::ThreadConfig& cfg);
+
+        // 현재 스레드에 적용 (스레드 진입부에서 호출)
+        void apply_current(ThreadRole role, const std::string& name);
+        // 외부에서 만든 스레드에 적용 (std::thread::native_handle)
+        void apply(std::thread::native_handle_type handle, ThreadRole role, const std::string& name);
+
+        const std::vector<int>& cpus(ThreadRole role) const;
+        // config "pin" (false 면 affinity 를 건드리지 않음)
+        bool pinned() const { return pin_; }
+
+        // 역할 CPU 셋의 첫 CPU 가 속한 NUMA 노드 (모르면 -1)
+        int numa_node(ThreadRole role) const;
+
+        // 틱 스레드 슬롯: tick CPU 셋을 slots 조각으로 나눠 틱 스레드마다 한 조각씩
+        //  - 필드는 자기를 돌릴 틱 슬롯의 CPU 에서 생성 -> 시뮬레이션 메모리가 그 스레드 노드에 잡힘
+        //  - configure() 다음, 필드 생성 전에 한 번
+        void set_tick_slots(int slots);
+        int  tick_slots() const { return tickSlots_; }
+        std::vector<int> tick_slot_cpus(int slot) const;
+        void apply_current_tick(int slot, const std::string& name);
+
+    private:
+        ThreadRoleRegistry() = default;
+        ThreadRoleRegistry(const ThreadRoleRegistry&) = delete;
+        ThreadRoleRegistry& operator=(const ThreadRoleRegistry&) = delete;
+
+        bool pin_ = false;
+        int  tickSlots_ = 1;
+        std::vector<int> cpus_[static_cast<int>(ThreadRole::Count)];
+    };
+
+    // 범위 안에서만 현재 스레드를 역할 CPU 셋에 묶어둠
+    //  - FieldWorker 생성처럼 "필드 메모리를 어느 노드에 둘지" 정하는 구간에 사용
+    //  - first-touch 정책으로 생성 중 할당되는 페이지가 해당 노드에 잡힘
+    //  - pin=false 면 아무것도 안 함
+    class ScopedThreadAffinity {
+    public:
+        explicit ScopedThreadAffinity(ThreadRole role);
+        explicit ScopedThreadAffinity(const std::vector<int>& cpus);
+        ~ScopedThreadAffinity();
+
+        ScopedThreadAffinity(const ScopedThreadAffinity&) = delete;
+        ScopedThreadAffinity& operator=(const ScopedThreadAffinity&) = delete;
+
+    private:
+        bool                       applied_ = false;
+        std::vector<std::uint64_t> oldMask_;   // 복원용 (64 CPU 단위 비트)
+        std::uint16_t              oldGroup_ = 0;
+    };
+
+} // namespace core
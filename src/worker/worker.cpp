@@ -1,12 +1,15 @@
 #include "worker.h"
 #include "workerManager.h"
+#include "net/session.h"
 
 namespace core {
 
-    // ================ Worker  ================
+    // ================ Worker 구현 ================
 
-    Worker::Worker(std::string name)
+    Worker::Worker(std::string name, ThreadRole role, bool ownThread)
         : name_(std::move(name))
+        , role_(role)
+        , ownThread_(ownThread)
     {
     }
 
@@ -17,10 +20,13 @@ namespace core {
     void Worker::start() {
         bool expected = false;
         if (!running_.compare_exchange_strong(expected, true)) {
-            // ̹  
+            // 이미 실행 중
             return;
         }
 
+        if (!ownThread_)
+            return;     // 큐는 주인이 take_pending 으로 비움
+
         thread_ = std::thread([this] {
             this->loop();
             });
@@ -29,13 +35,13 @@ namespace core {
     void Worker::stop() {
         bool expected = true;
         if (!running_.compare_exchange_strong(expected, false)) {
-            // ̹ 
+            // 이미 정지
             return;
         }
 
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            // ť ־ 
+            // 큐가 비어있어도 깨우기
         }
         cv_.notify_all();
 
@@ -57,6 +63,8 @@ namespace core {
     }
 
     void Worker::loop() {
+        ThreadRoleRegistry::instance().apply_current(role_, name_);
+
         while (running_.load()) {
             NetMessage msg;
 
@@ -79,36 +87,101 @@ namespace core {
         }
     }
 
+    void Worker::take_pending(std::queue<NetMessage>& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty())
+            return;
+        if (out.empty())
+            out.swap(queue_);
+        else {
+            while (!queue_.empty()) {
+                out.push(std::move(queue_.front()));
+                queue_.pop();
+            }
+        }
+    }
+
     INT32 Worker::GetMessageCount()
     {
         std::lock_guard<std::mutex> lock(mutex_);
         return static_cast<INT32>(queue_.size());
     }
 
-    // ================ GameWorker   ================
+    // ================ GameWorker 헬퍼 구현 ================
+
+    // 시작 시 한 번 만들고 이후에는 읽기만 함
+    static std::mutex               g_gameShardMutex;
+    static std::vector<Worker::Ptr> g_gameShards;
+
+    static std::string make_game_worker_name(std::size_t index)
+    {
+        return std::string(GAME_WORKER_NAME) + "_" + std::to_string(index);
+    }
 
     Worker::Ptr GetGameWorker() {
-        return WorkerManager::instance().get(GAME_WORKER_NAME);
+        return GetGameWorkerShard(0);
     }
 
     bool CreateGameWorker() {
-        auto& mgr = WorkerManager::instance();
-        auto existing = mgr.get(GAME_WORKER_NAME);
-        if (existing) return true;
+        return CreateGameWorkers(1);
+    }
 
-        auto worker = std::make_shared<Worker>(GAME_WORKER_NAME);
-        if (!worker) return false;
+    bool CreateGameWorkers(std::size_t shardCount) {
+        if (shardCount == 0) shardCount = 1;
 
-        if (!mgr.insert(GAME_WORKER_NAME, worker))
-            return false;
+        std::lock_guard<std::mutex> lock(g_gameShardMutex);
+        if (!g_gameShards.empty()) return true;
 
-        worker->start();
+        auto& mgr = WorkerManager::instance();
+        std::vector<Worker::Ptr> shards;
+        shards.reserve(shardCount);
+
+        for (std::size_t i = 0; i < shardCount; ++i) {
+            const std::string name = make_game_worker_name(i);
+            auto worker = std::make_shared<Worker>(name);
+            if (!mgr.insert(name, worker)) {
+                // 중간에 실패하면 앞서 넣은 샤드도 빼서 반쪽 등록(시작 안 된 워커)이 남지 않게
+                for (std::size_t j = 0; j < shards.size(); ++j)
+                    mgr.remove(make_game_worker_name(j));
+                return false;
+            }
+            shards.push_back(worker);
+        }
+
+        for (auto& w : shards)
+            w->start();
+
+        g_gameShards = std::move(shards);
         return true;
     }
 
+    std::size_t GameWorkerShardCount() {
+        std::lock_guard<std::mutex> lock(g_gameShardMutex);
+        return g_gameShards.size();
+    }
+
+    Worker::Ptr GetGameWorkerShard(std::size_t index) {
+        std::lock_guard<std::mutex> lock(g_gameShardMutex);
+        if (index >= g_gameShards.size()) return nullptr;
+        return g_gameShards[index];
+    }
+
+    std::vector<Worker::Ptr> GetGameWorkerShards() {
+        std::lock_guard<std::mutex> lock(g_gameShardMutex);
+        return g_gameShards;
+    }
+
     bool SendToGameWorker(NetMessage msg) {
-        auto worker = GetGameWorker();
-        if (!worker) return false;
+        const std::uint64_t key = msg.session ? msg.session->session_id() : 0;
+
+        Worker::Ptr worker;
+        {
+            std::lock_guard<std::mutex> lock(g_gameShardMutex);
+            if (g_gameShards.empty()) return false;
+            worker = g_gameShards[GameShardIndex(key, g_gameShards.size())];
+        }
+
         worker->push(std::move(msg));
         return true;
     }
@@ -6,69 +6,152 @@
 #include <queue>
 #include <unordered_map>
 #include <atomic>
+#include <chrono>
+#include <variant>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <cstdint>
 #include "core/core_types.h"
+#include "worker/threadRole.h"
+#include "worker/payloadBuffer.h"
+#include "field/NameTable.h"
 
 namespace net {
-    class Session; // forward declaration (mmorpg_skel  net::Session  )
+    class Session; // forward declaration (mmorpg_skel 의 net::Session 과 연결)
 }
 
 namespace core {
 
-    // Ŀ ó ޽ Ÿ (ʿϸ  ߰ص )
+    class Player;
+
+    // 워커가 처리할 메시지 타입 (필요하면 더 추가해도 됨)
     enum class MessageType : uint8_t {
-        NetEnvelope = 0,   // Ʈũ Ŷ(FlatBuffers Envelope)
-        Custom = 1,   // Ÿ 뵵
-        EnterField = 2,   // ʵ 
-        LeaveField = 3,   // ʵ 
-        MoveField = 4,   // ʵ  ̵
-		SkillCmd = 5,   // ų Ŀǵ
+        NetEnvelope = 0,   // 네트워크 패킷(FlatBuffers Envelope)
+        Custom = 1,   // 기타 용도
+        EnterField = 2,   // 필드 입장
+        LeaveField = 3,   // 필드 퇴장
+        MoveField = 4,   // 필드 내 이동
+		SkillCmd = 5,   // 스킬 커맨드
+        SkillEnvelope = 6,   // I/O 스레드에서 검증 끝난 SkillCmd Envelope (GameWorker 우회)
+        Internal = 7,   // 서버 내부 명령 (NetMessage::cmd, 직렬화 없음)
+    };
+
+    // ----- 서버 내부 명령: 워커 간에는 FlatBuffers 대신 타입 있는 구조체로 전달 -----
+    //  - 와이어 포맷(FlatBuffers)은 네트워크 경계에서만 사용
+    struct CmdMovePlayer {          // 플레이어 절대좌표 이동 (텔레포트/보정)
+        std::uint64_t playerId = 0;
+        float         x = 0.f;
+        float         y = 0.f;
+    };
+
+    // ----- 리전 경계 (한 필드를 여러 FieldWorker 가 나눠 맡을 때) -----
+    //  - 소유 리전이 틱 끝에 경계 근처 엔티티를 인접 리전에 ghost 로 복제 (변경분만)
+    struct GhostState {
+        std::uint64_t id = 0;
+        float         x = 0.f;
+        float         y = 0.f;
+        float         vx = 0.f;     // 속도 (ghost 쪽 watcher 도 같은 dead reckoning)
+        float         vy = 0.f;
+        bool          isMonster = false;
+        NameId        prefab = kNoName;   // 처음 복제할 때만 채움
+    };
+
+    struct CmdGhostSync {
+        int                        fromRegion = 0;
+        std::vector<GhostState>    updates;
+        std::vector<std::uint64_t> removes;
+    };
+
+    // 플레이어 소유권 이전 (이전 리전 -> 새 리전)
+    struct CmdHandoffPlayer {
+        std::shared_ptr<Player>    player;
+        std::vector<std::uint64_t> visible;    // 클라가 이미 보고 있는 엔티티 (중복 Enter 방지)
+        std::vector<int>           mirroredTo; // 이 플레이어의 ghost 가 있는 리전 (정리 책임 이전)
+    };
+
+    // 인접 리전 소유 몬스터(ghost)를 때린 스킬 -> 소유 리전이 처리
+    struct CmdGhostSkill {
+        std::uint64_t attackerId = 0;
+        std::uint64_t targetId = 0;
+        int           skill = 0;        // game::SkillType
     };
 
-    // Ʈũ ޽:  ǿ   payloadΰ
+    // 소유 리전의 AI 상태/스탯 브로드캐스트 -> ghost 를 보는 인접 리전 watcher 에게도
+    struct CmdGhostEvent {
+        enum class Kind : std::uint8_t { AiState, Stat };
+        Kind          kind = Kind::AiState;
+        std::uint64_t id = 0;
+        bool          isMonster = false;
+        std::uint8_t  state = 0;        // field::AiStateType
+        int           hp = 0;
+        int           maxHp = 0;
+        int           sp = 0;
+        int           maxSp = 0;
+    };
+
+    // 필드 입장/퇴장 (게임 샤드 -> FieldWorker, players_ 는 필드 틱 스레드에서만 건드림)
+    struct CmdEnterPlayer {
+        std::shared_ptr<Player>    player;
+    };
+
+    struct CmdLeavePlayer {
+        std::uint64_t playerId = 0;
+    };
+
+    using InternalCmd = std::variant<std::monostate, CmdMovePlayer, CmdGhostSync, CmdHandoffPlayer,
+        CmdEnterPlayer, CmdLeavePlayer, CmdGhostSkill, CmdGhostEvent>;
+
+    // 네트워크 메시지: 어떤 세션에서 온 어떤 payload인가
     struct NetMessage {
         MessageType                      type{ MessageType::NetEnvelope };
-        std::shared_ptr<net::Session>    session;   //  
-        std::vector<uint8_t>             payload;   // FlatBuffers raw bytes
+        std::shared_ptr<net::Session>    session;   // 보낸 세션
+        PayloadBuffer                    payload;   // FlatBuffers raw bytes (128B 이하 인라인)
+        std::chrono::steady_clock::time_point recvTime{}; // I/O 스레드 수신 시각 (지연 측정용)
+        InternalCmd                      cmd;       // type == Internal 일 때만 사용
     };
 
-    //  Ŀ
+    // 단일 워커스레드
     class Worker {
     public:
         using Ptr = std::shared_ptr<Worker>;
         using Callback = std::function<void(const NetMessage&)>;
 
-        explicit Worker(std::string name);
+        // ownThread=false: 스레드 없이 큐만 둠. 주인(틱 스레드 등)이 take_pending 으로 직접 꺼냄
+        explicit Worker(std::string name, ThreadRole role = ThreadRole::Game, bool ownThread = true);
         virtual ~Worker();
 
-        // Ŀ  /
+        // 워커 스레드 시작/정지
         void start();
         void stop();
 
-        // ͸
+        // 모니터링
         INT32 GetMessageCount();
 
-        // ޽ enqueue
+        // 메시지 enqueue
         void push(NetMessage msg);
 
-        // ޽ ó ݹ (Ŀ  ȿ ȣ)
+        // 메시지 처리 콜백 (워커 스레드 안에서 호출됨)
         void set_on_message(Callback cb);
 
         const std::string& name() const { return name_; }
 
-        // ?? ͸: OS  ڵ ȯ
+        // ?? 모니터링용: OS 쓰레드 핸들 반환
         std::thread::native_handle_type native_handle() {
             return thread_.native_handle();
         }
 
+    protected:
+        // 쌓인 메시지를 통째로 넘김 (복사 없이 큐 swap). ownThread=false 인 워커용
+        void take_pending(std::queue<NetMessage>& out);
+
     private:
-        void loop(); //   
+        void loop(); // 내부 스레드 루프
 
         std::string              name_;
+        ThreadRole               role_{ ThreadRole::Game };
+        bool                     ownThread_ = true;
         std::atomic<bool>        running_{ false };
         std::thread              thread_;
 
@@ -78,11 +161,22 @@ namespace core {
         Callback                 on_message_;
     };
 
-    //  Լ: "GameWorker" ̸ ϳ ϰ  
+    // 편의 함수: "GameWorker_N" 이름으로 샤드 여러 개를 관리
+    //  - 같은 세션의 패킷은 항상 같은 샤드로 가야 순서가 보장됨
     inline constexpr char GAME_WORKER_NAME[] = "GameWorker";
 
-    Worker::Ptr  GetGameWorker();          //  nullptr
-    bool         CreateGameWorker();       //  
-    bool         SendToGameWorker(NetMessage msg);
+    Worker::Ptr  GetGameWorker();          // 0번 샤드 (없으면 nullptr)
+    bool         CreateGameWorker();       // 샤드 1개로 생성
+    bool         CreateGameWorkers(std::size_t shardCount); // 없으면 shardCount 개 생성
+    bool         SendToGameWorker(NetMessage msg);          // msg.session 기준으로 샤드 선택
+
+    std::size_t  GameWorkerShardCount();
+    Worker::Ptr  GetGameWorkerShard(std::size_t index);
+    std::vector<Worker::Ptr> GetGameWorkerShards();
+
+    // 라우팅 키(sessionId) -> 샤드 인덱스. 세션 수명 동안 항상 같은 값
+    inline std::size_t GameShardIndex(std::uint64_t key, std::size_t shardCount) {
+        return shardCount > 1 ? static_cast<std::size_t>(key % shardCount) : 0;
+    }
 
 } // namespace core
@@ -15,20 +15,20 @@
 #include "worker.h"
 
 namespace net {
-    class Session; // forward declaration (mmorpg_skel  net::Session  )
+    class Session; // forward declaration (mmorpg_skel 의 net::Session 과 연결)
 }
 
 namespace core {
 
-    //  Ŀ ̸ ϴ  Ŵ
+    // 여러 워커를 이름으로 관리하는 간단한 매니저
     class WorkerManager {
     public:
         using key_type = std::string;
 
-        // ̱ νϽ (core::WorkerManager::instance()  )
+        // 싱글턴 인스턴스 (core::WorkerManager::instance() 로 사용)
         static WorkerManager& instance();
 
-        // Ŀ /ȸ/
+        // 워커 등록/조회/정지
         bool insert(const key_type& key, Worker::Ptr worker);
         Worker::Ptr get(const key_type& key);
         void remove(const key_type& key);